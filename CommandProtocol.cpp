@@ -0,0 +1,155 @@
+// CommandProtocol.cpp
+// Author: Aishwarya and Archita
+// Date: December 2025
+// Purpose: Implementation of the binary command encoder and decoder
+
+#include "CommandProtocol.h"
+#include <cstring>
+
+namespace RepCRec {
+
+namespace {
+
+// Bytes a name occupies after its DEFINE_NAME frame
+size_t paddedNameBytes(size_t length) {
+    return (length + sizeof(CommandFrame) - 1) / sizeof(CommandFrame) * sizeof(CommandFrame);
+}
+
+}
+
+BinaryScriptWriter::BinaryScriptWriter() {
+    uint32_t header[4] = { BINARY_SCRIPT_MAGIC, BINARY_SCRIPT_VERSION, 0, 0 };
+    bytes.resize(BINARY_SCRIPT_HEADER_BYTES);
+    std::memcpy(bytes.data(), header, sizeof(header));
+}
+
+void BinaryScriptWriter::putFrame(CommandOpcode opcode, int32_t transaction,
+                                  int32_t target, int32_t value) {
+    CommandFrame frame = {};
+    frame.opcode = static_cast<uint8_t>(opcode);
+    frame.transaction = transaction;
+    frame.target = target;
+    frame.value = value;
+
+    size_t offset = bytes.size();
+    bytes.resize(offset + sizeof(frame));
+    std::memcpy(bytes.data() + offset, &frame, sizeof(frame));
+}
+
+void BinaryScriptWriter::putTextFrame(CommandOpcode opcode, int32_t transaction,
+                                      std::string_view text) {
+    putFrame(opcode, transaction, static_cast<int32_t>(text.size()), 0);
+    size_t offset = bytes.size();
+    bytes.resize(offset + paddedNameBytes(text.size()), 0);
+    std::memcpy(bytes.data() + offset, text.data(), text.size());
+}
+
+int32_t BinaryScriptWriter::nameIdFor(std::string_view name) {
+    auto [it, inserted] = nameIds.emplace(std::string(name), static_cast<int32_t>(nameIds.size()));
+    if (inserted) {
+        putTextFrame(CommandOpcode::DEFINE_NAME, it->second, name);
+    }
+    return it->second;
+}
+
+void BinaryScriptWriter::append(const ScriptCommand& command) {
+    int32_t transaction = -1;
+    switch (command.opcode) {
+        case CommandOpcode::BEGIN:
+        case CommandOpcode::READ:
+        case CommandOpcode::WRITE:
+        case CommandOpcode::END:
+            transaction = nameIdFor(command.transactionName);
+            break;
+        default:
+            break;
+    }
+    putFrame(command.opcode, transaction, command.target, command.value);
+}
+
+void BinaryScriptWriter::appendError(std::string_view message) {
+    putTextFrame(CommandOpcode::COMMAND_ERROR, -1, message);
+}
+
+BinaryScriptReader::BinaryScriptReader(const char* data, size_t length)
+    : cursor(data), limit(data + length) {
+    uint32_t header[4] = {};
+    if (length < BINARY_SCRIPT_HEADER_BYTES) {
+        error = "missing binary script header";
+        cursor = limit;
+        return;
+    }
+    std::memcpy(header, data, sizeof(header));
+    if (header[0] != BINARY_SCRIPT_MAGIC || header[1] < 1 || header[1] > BINARY_SCRIPT_VERSION) {
+        error = "not a binary script (bad magic or version)";
+        cursor = limit;
+        return;
+    }
+    cursor += BINARY_SCRIPT_HEADER_BYTES;
+}
+
+bool BinaryScriptReader::next(CommandView& command) {
+    while (static_cast<size_t>(limit - cursor) >= sizeof(CommandFrame)) {
+        CommandFrame frame;
+        std::memcpy(&frame, cursor, sizeof(frame));
+        cursor += sizeof(frame);
+
+        auto opcode = static_cast<CommandOpcode>(frame.opcode);
+        if (opcode == CommandOpcode::DEFINE_NAME) {
+            size_t nameBytes = paddedNameBytes(static_cast<size_t>(frame.target));
+            if (frame.target < 0 || frame.transaction != static_cast<int32_t>(names.size()) ||
+                nameBytes > static_cast<size_t>(limit - cursor)) {
+                error = "malformed name definition";
+                cursor = limit;
+                return false;
+            }
+            names.emplace_back(cursor, static_cast<size_t>(frame.target));
+            cursor += nameBytes;
+            continue;
+        }
+
+        if (frame.opcode > static_cast<uint8_t>(CommandOpcode::COMMAND_ERROR)) {
+            error = "unknown opcode " + std::to_string(frame.opcode);
+            cursor = limit;
+            return false;
+        }
+
+        command.opcode = opcode;
+        command.transactionName = nullptr;
+        command.target = frame.target;
+        command.value = frame.value;
+        command.error = std::string_view();
+
+        if (opcode == CommandOpcode::COMMAND_ERROR) {
+            size_t messageBytes = paddedNameBytes(static_cast<size_t>(frame.target));
+            if (frame.target < 0 || messageBytes > static_cast<size_t>(limit - cursor)) {
+                error = "malformed error frame";
+                cursor = limit;
+                return false;
+            }
+            command.error = std::string_view(cursor, static_cast<size_t>(frame.target));
+            cursor += messageBytes;
+            return true;
+        }
+
+        if (opcode == CommandOpcode::BEGIN || opcode == CommandOpcode::READ ||
+            opcode == CommandOpcode::WRITE || opcode == CommandOpcode::END) {
+            if (frame.transaction < 0 ||
+                frame.transaction >= static_cast<int32_t>(names.size())) {
+                error = "undefined transaction name id " + std::to_string(frame.transaction);
+                cursor = limit;
+                return false;
+            }
+            command.transactionName = &names[frame.transaction];
+        }
+        return true;
+    }
+
+    if (cursor != limit) {
+        error = "truncated frame at end of script";
+        cursor = limit;
+    }
+    return false;
+}
+
+}
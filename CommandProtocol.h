@@ -0,0 +1,167 @@
+// CommandProtocol.h
+// Author: Aishwarya and Archita
+// Date: December 2025
+// Purpose: Compact binary framing of script commands (for bulk trace replay)
+//          and its zero-copy decoder
+// Side effects: None - encodes to and decodes from memory buffers
+
+#ifndef COMMANDPROTOCOL_H
+#define COMMANDPROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace RepCRec {
+
+enum class CommandOpcode : uint8_t {
+    DEFINE_NAME = 0,  // Binds a transaction name to an id for later frames
+    BEGIN = 1,
+    READ = 2,
+    WRITE = 3,
+    END = 4,
+    FAIL = 5,
+    RECOVER = 6,
+    DUMP = 7,
+    COMMAND_ERROR = 8  // A malformed text line, replayed as an error report
+};
+
+// One decoded text command. target is the variable for R/W and the site for
+// fail/recover; value is used by W only. transactionName points into the line
+// it was parsed from.
+struct ScriptCommand {
+    CommandOpcode opcode;
+    std::string_view transactionName;
+    int target;
+    int value;
+
+    ScriptCommand() : opcode(CommandOpcode::DUMP), target(0), value(0) {}
+};
+
+// Binary script layout (host byte order):
+//   uint32 magic | uint32 version | uint32 reserved[2]
+//   CommandFrame... where a DEFINE_NAME frame is followed by its name bytes
+//   and a COMMAND_ERROR frame by its message bytes, zero-padded to a multiple
+//   of sizeof(CommandFrame) so frames stay aligned
+struct CommandFrame {
+    uint8_t opcode;
+    uint8_t reserved[3];
+    int32_t transaction;  // Name id (DEFINE_NAME: the id being defined)
+    int32_t target;       // Variable or site (DEFINE_NAME, COMMAND_ERROR: text length)
+    int32_t value;
+};
+
+static_assert(sizeof(CommandFrame) == 16, "CommandFrame must stay 16 bytes");
+
+// "RCBS": RepCRec binary script
+const uint32_t BINARY_SCRIPT_MAGIC = 0x53424352;
+// Version 2 added COMMAND_ERROR; version 1 scripts still decode
+const uint32_t BINARY_SCRIPT_VERSION = 2;
+const size_t BINARY_SCRIPT_HEADER_BYTES = 4 * sizeof(uint32_t);
+
+class BinaryScriptWriter {
+private:
+    std::vector<char> bytes;
+    std::unordered_map<std::string, int32_t> nameIds;
+
+    void putFrame(CommandOpcode opcode, int32_t transaction, int32_t target, int32_t value);
+
+    // Frame followed by text, padded to the frame size
+    void putTextFrame(CommandOpcode opcode, int32_t transaction, std::string_view text);
+
+    // Id of name, emitting its DEFINE_NAME frame on first use
+    int32_t nameIdFor(std::string_view name);
+
+public:
+    BinaryScriptWriter();
+
+    /**
+     * append - Encode one command
+     * Author: Archita Arora
+     * Input:
+     *   - command (ScriptCommand): Command parsed from a text script
+     * Output: None
+     * Description: Appends one fixed-size frame, preceded by a DEFINE_NAME
+     *              frame the first time a transaction name appears. Names are
+     *              therefore stored once per script, not once per command.
+     * Side Effects: Grows the encoded buffer
+     */
+    void append(const ScriptCommand& command);
+
+    /**
+     * appendError - Encode a malformed line
+     * Author: Aishwarya Anand
+     * Input:
+     *   - message (string_view): What the text parser reported for the line
+     * Output: None
+     * Description: Appends a COMMAND_ERROR frame carrying the message, so a
+     *              replay reports the line in order, exactly as running the
+     *              text script does.
+     * Side Effects: Grows the encoded buffer
+     */
+    void appendError(std::string_view message);
+
+    const std::vector<char>& getBytes() const {
+        return bytes;
+    }
+};
+
+// A decoded frame; transactionName points into the reader's name table and
+// stays valid until the next call to next(). error (COMMAND_ERROR only) points
+// into the script itself.
+struct CommandView {
+    CommandOpcode opcode;
+    const std::string* transactionName;
+    int target;
+    int value;
+    std::string_view error;
+};
+
+class BinaryScriptReader {
+private:
+    const char* cursor;
+    const char* limit;
+    std::vector<std::string> names;  // id -> name, from DEFINE_NAME frames
+    std::string error;
+
+public:
+    /**
+     * BinaryScriptReader Constructor
+     * Author: Aishwarya Anand
+     * Input:
+     *   - data (const char*): Encoded script; must outlive the reader
+     *   - length (size_t): Bytes at data
+     * Output: None (constructor)
+     * Description: Checks the header. Frames are then decoded in place, one
+     *              fixed-size load each; the only allocations are the name
+     *              table entries, one per distinct transaction name.
+     * Side Effects: Sets the error if the header is missing or wrong
+     */
+    BinaryScriptReader(const char* data, size_t length);
+
+    /**
+     * next - Decode the next executable command
+     * Author: Archita Arora
+     * Input:
+     *   - command (CommandView&): Filled with the decoded command
+     * Output: Boolean - false at end of input or on a malformed frame
+     * Description: Consumes DEFINE_NAME frames silently. A truncated frame, an
+     *              unknown opcode or an undefined name id stops decoding and
+     *              sets getError(). COMMAND_ERROR frames are returned like
+     *              commands, with the message in command.error.
+     * Side Effects: Advances the cursor; may extend the name table
+     */
+    bool next(CommandView& command);
+
+    // Empty unless the input was malformed
+    const std::string& getError() const {
+        return error;
+    }
+};
+
+}
+
+#endif
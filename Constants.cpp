@@ -4,31 +4,128 @@
 // Purpose: Implementation of utility functions for the distributed database
 
 #include "Constants.h"
+#include <algorithm>
 
 namespace RepCRec {
 
+namespace {
+
+// Precomputed placement: variableId -> sites storing it (index 0 unused)
+struct Catalog {
+    CatalogConfig config;
+    int evenReplicas;
+    int slotBlockSize;  // variables per residue class, see getSlotAtSite()
+    std::vector<SiteSet> placement;
+};
+
+Catalog buildCatalog(const CatalogConfig& config) {
+    Catalog catalog;
+    catalog.config = config;
+    catalog.evenReplicas = (config.replicationFactor <= 0 || 
+                            config.replicationFactor >= config.numSites) 
+                           ? config.numSites : config.replicationFactor;
+    catalog.slotBlockSize = config.numVariables / config.numSites + 1;
+    catalog.placement.resize(config.numVariables + 1);
+    
+    for (int varId = 1; varId <= config.numVariables; varId++) {
+        int replicas = (varId % 2 == 1) ? 1 : catalog.evenReplicas;
+        for (int k = 0; k < replicas; k++) {
+            catalog.placement[varId].insert(1 + (varId + k) % config.numSites);
+        }
+    }
+    return catalog;
+}
+
+Catalog& activeCatalog() {
+    static Catalog catalog = buildCatalog(CatalogConfig());
+    return catalog;
+}
+
+const SiteSet NO_SITES;
+
+}
+
+bool configureCatalog(const CatalogConfig& config) {
+    if (config.numVariables < 1 || config.numSites < 1 || config.numSites > MAX_SITES || 
+        config.replicationFactor < 0) {
+        return false;
+    }
+    activeCatalog() = buildCatalog(config);
+    return true;
+}
+
+int getNumVariables() {
+    return activeCatalog().config.numVariables;
+}
+
+int getNumSites() {
+    return activeCatalog().config.numSites;
+}
+
 bool isOddVariable(int varId) {
     return varId % 2 == 1;
 }
 
 bool isReplicatedVariable(int varId) {
-    return varId % 2 == 0;
+    return getVariableSites(varId).size() > 1;
 }
 
 int getHomeSite(int varId) {
-    return 1 + (varId % NUM_SITES);
+    return 1 + (varId % getNumSites());
+}
+
+const SiteSet& getVariableSites(int varId) {
+    const Catalog& catalog = activeCatalog();
+    if (varId < 1 || varId > catalog.config.numVariables) {
+        return NO_SITES;
+    }
+    return catalog.placement[varId];
 }
 
-std::set<int> getVariableSites(int varId) {
-    std::set<int> sites;
-    if (isOddVariable(varId)) {
-        sites.insert(getHomeSite(varId));
-    } else {
-        for (int i = 1; i <= NUM_SITES; i++) {
-            sites.insert(i);
+std::vector<int> getVariablesAtSite(int siteId) {
+    const Catalog& catalog = activeCatalog();
+    int numSites = catalog.config.numSites;
+    int numVariables = catalog.config.numVariables;
+    std::vector<int> variables;
+    
+    // Site s holds variable v iff s = 1 + (v + k) mod numSites for some replica 
+    // offset k, so each k selects one residue class of v; stride through it 
+    // instead of scanning every variable id
+    for (int k = 0; k < catalog.evenReplicas; k++) {
+        int residue = ((siteId - 1 - k) % numSites + numSites) % numSites;
+        for (int varId = residue == 0 ? numSites : residue; varId <= numVariables; 
+             varId += numSites) {
+            if (!isOddVariable(varId) || k == 0) {
+                variables.push_back(varId);
+            }
         }
     }
-    return sites;
+    
+    std::sort(variables.begin(), variables.end());
+    return variables;
+}
+
+int getSlotAtSite(int varId, int siteId) {
+    const Catalog& catalog = activeCatalog();
+    int numSites = catalog.config.numSites;
+    if (varId < 1 || varId > catalog.config.numVariables) {
+        return -1;
+    }
+    
+    // Replica offset k of this site for varId (site = 1 + (varId + k) mod numSites)
+    int k = ((siteId - 1 - varId) % numSites + numSites) % numSites;
+    int replicas = isOddVariable(varId) ? 1 : catalog.evenReplicas;
+    if (k >= replicas) {
+        return -1;
+    }
+    
+    // One block per replica offset; within a block varId / numSites is unique
+    return k * catalog.slotBlockSize + varId / numSites;
+}
+
+int getSlotCount() {
+    const Catalog& catalog = activeCatalog();
+    return catalog.evenReplicas * catalog.slotBlockSize;
 }
 
 std::string statusToString(TransactionStatus status) {
@@ -41,4 +138,4 @@ std::string statusToString(TransactionStatus status) {
     return "UNKNOWN";
 }
 
-} 
\ No newline at end of file
+} 
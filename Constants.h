@@ -6,16 +6,31 @@
 #ifndef CONSTANTS_H
 #define CONSTANTS_H
 
+#include "SiteSet.h"
 #include <string>
-#include <set>
+#include <vector>
 
 namespace RepCRec {
 
-// System configuration
-const int NUM_VARIABLES = 20;
-const int NUM_SITES = 10;
+// Default system configuration (the course setup: x1..x20 over 10 sites)
+const int DEFAULT_NUM_VARIABLES = 20;
+const int DEFAULT_NUM_SITES = 10;
 const int INITIAL_VALUE_MULTIPLIER = 10;
 
+// Catalog layout chosen at startup, before any TransactionManager is built.
+// Odd variables live at one home site (1 + i mod numSites). Even variables are
+// replicated at replicationFactor consecutive sites starting at their home
+// site, wrapping around; 0 (or >= numSites) means every site.
+struct CatalogConfig {
+    int numVariables;
+    int numSites;
+    int replicationFactor;
+    
+    CatalogConfig() 
+        : numVariables(DEFAULT_NUM_VARIABLES), numSites(DEFAULT_NUM_SITES), 
+          replicationFactor(0) {}
+};
+
 // Transaction status
 enum class TransactionStatus {
     ACTIVE,
@@ -24,13 +39,83 @@ enum class TransactionStatus {
     ABORTED
 };
 
+// RW-conflict validation performed at commit
+enum class ValidationMode {
+    STRICT_GRAPH,   // Full DFS/BFS search of the RW conflict graph
+    PIVOT_FLAGS     // Incremental SSI in-/out-conflict flags, O(1) per commit
+};
+
+// Where per-site DataManager work runs
+enum class ExecutionMode {
+    DETERMINISTIC,  // Inline on the caller's thread, sites in ascending order
+    SITE_THREADS    // One worker thread and message queue per site
+};
+
+// How TransactionManager events are rendered (see EventSink.h)
+enum class OutputFormat {
+    TEXT,        // Human-readable lines, the original output
+    JSON_LINES,  // One JSON object per event, for machine checking
+    NONE         // Discarded (benchmarks)
+};
+
+// Which valid replica serves a replicated read
+enum class ReplicaSelection {
+    LOWEST_SITE,        // Lowest-numbered valid site (the original behaviour)
+    ROUND_ROBIN,        // Rotate over sites across successive reads
+    LEAST_OUTSTANDING,  // Fewest reads held by in-flight transactions
+    AFFINITY            // Sites this transaction already uses, else a per-transaction home
+};
+
+// How a recovered site becomes readable again for replicated variables
+enum class RecoveryMode {
+    READ_GATE,  // Each variable stays unreadable until a new write commits to it
+    CATCH_UP    // Missed versions are copied from an up-to-date peer at recovery
+};
+
+// How far a commit is persisted to a site's write-ahead log before "commits" 
+// is reported
+enum class DurabilityLevel {
+    OFF,    // No log; committed data lives only in memory
+    ASYNC,  // Each commit record is written to the OS, never fsync'd
+    GROUP,  // Written per commit, fsync'd once per groupCommitSize commits;
+            // the group's "commits" lines wait for that fsync, which also
+            // runs whenever the parser has run all input read so far, so a
+            // commit is reported at the latest before the next stdin read
+    SYNC    // Written and fsync'd before each commit returns
+};
+
+// Write-ahead log settings shared by every site
+struct WalConfig {
+    DurabilityLevel durability;
+    std::string directory;   // One site<N>.wal file per site
+    int groupCommitSize;     // Commits per fsync under GROUP
+    int checkpointInterval;  // Commits between checkpoints (0 = never)
+    
+    WalConfig() 
+        : durability(DurabilityLevel::OFF), directory("repcrec_wal"), groupCommitSize(8),
+          checkpointInterval(256) {}
+};
+
 // Function declarations (definitions in Constants.cpp)
+
+// Rebuilds the placement table; returns false (and keeps the old catalog) if
+// the configuration is out of range
+bool configureCatalog(const CatalogConfig& config);
+int getNumVariables();
+int getNumSites();
+
 bool isOddVariable(int varId);
 bool isReplicatedVariable(int varId);
 int getHomeSite(int varId);
-std::set<int> getVariableSites(int varId);
+const SiteSet& getVariableSites(int varId);
+std::vector<int> getVariablesAtSite(int siteId);
+
+// Dense per-site storage slot of a variable, or -1 if the site does not hold 
+// it. Slots are in [0, getSlotCount()) and computed arithmetically (O(1)).
+int getSlotAtSite(int varId, int siteId);
+int getSlotCount();
 std::string statusToString(TransactionStatus status);
 
 } 
 
-#endif 
\ No newline at end of file
+#endif
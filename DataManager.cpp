@@ -5,105 +5,422 @@
 
 #include "DataManager.h"
 #include <algorithm>
+#include <chrono>
+#include <climits>
+#include <stdexcept>
 #include <iostream>
+#include <iterator>
 
 namespace RepCRec {
 
-DataManager::DataManager(int id) 
-    : siteId(id), isUp(true), lastRecoveryTime(0) {
+namespace {
+
+// Latest version in a commit-ordered chain with commitTimestamp <= snapshotTime;
+// binary search over the published part of the timestamp column only
+VersionView findInChain(const VersionChain& chain, int snapshotTime) {
+    // A concurrent commit may retire the block; it stays allocated until the 
+    // guard is released, by which time the version has been copied out
+    EpochGuard guard;
+    const VersionBlock* block = chain.load();
+    if (!block) {
+        return VersionView();
+    }
+    
+    const int* timestamps = block->commitTimestamps.get();
+    const int* end = timestamps + block->size();
+    const int* it = std::upper_bound(timestamps, end, snapshotTime);
+    
+    if (it == timestamps) {
+        return VersionView();
+    }
+    
+    return VersionView(*block, static_cast<int>(std::prev(it) - timestamps));
+}
+
+// Newest published version of a chain (empty view if none)
+VersionView newestInChain(const VersionChain& chain) {
+    EpochGuard guard;
+    const VersionBlock* block = chain.load();
+    int count = block ? block->size() : 0;
+    return count > 0 ? VersionView(*block, count - 1) : VersionView();
+}
+
+// A transaction's write buffer at one site, allocated (map object included)
+// from the transaction's arena
+FlatMap<int, int>* newWriteBuffer(std::pmr::memory_resource* arena) {
+    void* memory = arena->allocate(sizeof(FlatMap<int, int>), alignof(FlatMap<int, int>));
+    return new (memory) FlatMap<int, int>(arena);
+}
+
+void deleteWriteBuffer(FlatMap<int, int>* writes) {
+    std::pmr::memory_resource* arena = writes->resource();
+    writes->~FlatMap();
+    arena->deallocate(writes, sizeof(FlatMap<int, int>), alignof(FlatMap<int, int>));
+}
+
+// "RCCK": site checkpoint
+const uint32_t CHECKPOINT_MAGIC = 0x4B434352;
+
+}
+
+DataManager::DataManager(int id, const WalConfig& walConfig) 
+    : siteId(id), isUp(true), lastRecoveryTime(0), dataStore(getSlotCount()), 
+      gcPending(getSlotCount(), 0), 
+      recoveryEpoch(0), replicaReadEpoch(getSlotCount()),
+      reclaimedVersionCount(0), reclaimedBytes(0), lastLoggedTimestamp(0),
+      lastLoadMicros(0), lastReplayedRecords(0) {
     initialize();
+    
+    if (walConfig.durability != DurabilityLevel::OFF) {
+        log = std::make_unique<WriteAheadLog>(walConfig, siteId);
+        checkpointPath = walConfig.directory + "/site" + std::to_string(siteId) + ".ckpt";
+        reloadFromDisk();
+        
+        for (const auto& chain : dataStore) {
+            if (VersionView newest = newestInChain(chain)) {
+                lastLoggedTimestamp = std::max(lastLoggedTimestamp, newest.commitTimestamp());
+            }
+        }
+    }
+}
+
+DataManager::~DataManager() {
+    for (const auto& [transactionId, writes] : writeBuffer) {
+        deleteWriteBuffer(writes);
+    }
 }
 
 void DataManager::initialize() {
-    for (int varId = 1; varId <= NUM_VARIABLES; varId++) {
-        std::set<int> sites = getVariableSites(varId);
+    for (auto& chain : dataStore) {
+        chain.clear();
+    }
+    for (auto& epoch : replicaReadEpoch) {
+        epoch.store(-1, std::memory_order_relaxed);
+    }
+    replicaCompleteEpoch.assign(getSlotCount(), -1);
+    
+    int epoch = recoveryEpoch.load(std::memory_order_relaxed);
+    for (int varId : getVariablesAtSite(siteId)) {
+        int slot = slotOf(varId);
+        int initialValue = varId * INITIAL_VALUE_MULTIPLIER;
+        dataStore[slot].append(Version(initialValue));
         
-        if (sites.find(siteId) != sites.end()) {
-            int initialValue = varId * INITIAL_VALUE_MULTIPLIER;
-            dataStore[varId].push_back(Version(initialValue));
-            
-            if (isReplicatedVariable(varId)) {
-                replicaReadEnabled[varId] = true;
-            }
+        if (isReplicatedVariable(varId)) {
+            replicaReadEpoch[slot].store(epoch, std::memory_order_release);
+            replicaCompleteEpoch[slot] = epoch;
         }
     }
 }
 
-std::shared_ptr<Version> DataManager::readVariable(int variableId, int snapshotTime) {
-    if (dataStore.find(variableId) == dataStore.end()) {
-        return nullptr;
+std::vector<VersionChain> DataManager::loadDurableState(long long& replayedRecords) const {
+    std::vector<VersionChain> store(getSlotCount());
+    int checkpointTimestamp = 0;
+    
+    MappedSnapshot snapshot(checkpointPath, CHECKPOINT_MAGIC);
+    if (snapshot.exists()) {
+        int slotCount = -1;
+        bool ok = snapshot.isValid() && snapshot.get(slotCount) && slotCount == getSlotCount() &&
+                  snapshot.get(checkpointTimestamp);
+        const size_t bytesPerVersion = 2 * sizeof(int);
+        for (auto& chain : store) {
+            uint32_t count = 0;
+            ok = ok && snapshot.get(count);
+            // A corrupt count must not size the allocation below
+            ok = ok && count <= static_cast<uint32_t>(INT_MAX) &&
+                 count <= snapshot.remaining() / bytesPerVersion;
+            if (!ok) {
+                break;
+            }
+            ok = chain.assignColumns(static_cast<int>(count), 
+                                     [&](int* timestamps, int* values, TxnId* writers) {
+                // Writer ids are not saved (see RECOVERED_TXN_ID)
+                std::fill_n(writers, count, RECOVERED_TXN_ID);
+                return snapshot.getArray(timestamps, count) &&
+                       snapshot.getArray(values, count);
+            });
+        }
+        if (!ok) {
+            throw std::runtime_error("Checkpoint " + checkpointPath + 
+                                     " is corrupt or was written for a different catalog");
+        }
+    } else {
+        for (int varId : getVariablesAtSite(siteId)) {
+            store[slotOf(varId)].append(Version(varId * INITIAL_VALUE_MULTIPLIER));
+        }
     }
     
-    if (isReplicatedVariable(variableId) && !replicaReadEnabled[variableId]) {
-        return nullptr;  
+    replayedRecords = 0;
+    log->replay([&](const LogRecord& record) {
+        // Left behind by a crash between checkpoint and log truncation
+        if (record.commitTimestamp <= checkpointTimestamp) {
+            return;
+        }
+        replayedRecords++;
+        for (int i = 0; i < record.writeCount; i++) {
+            const auto& [variableId, value] = record.writes[i];
+            int slot = slotOf(variableId);
+            if (slot >= 0) {
+                store[slot].append(Version(value, record.commitTimestamp, RECOVERED_TXN_ID));
+            }
+        }
+    });
+    
+    return store;
+}
+
+void DataManager::reloadFromDisk() {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<VersionChain> loaded = loadDurableState(lastReplayedRecords);
+    for (int slot = 0; slot < getSlotCount(); slot++) {
+        dataStore[slot].replaceWith(loaded[slot]);
+        markForGc(slot);
+    }
+    lastLoadMicros = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+void DataManager::checkpoint() {
+    if (!log || !isUp) {
+        return;
     }
     
-    auto& versions = dataStore[variableId];
-    std::shared_ptr<Version> result = nullptr;
+    int checkpointTimestamp = 0;
+    for (const auto& chain : dataStore) {
+        if (VersionView newest = newestInChain(chain)) {
+            checkpointTimestamp = std::max(checkpointTimestamp, newest.commitTimestamp());
+        }
+    }
     
-    for (auto it = versions.rbegin(); it != versions.rend(); ++it) {
-        if (it->commitTimestamp <= snapshotTime) {
-            result = std::make_shared<Version>(*it);
-            break;
+    SnapshotWriter writer(CHECKPOINT_MAGIC);
+    writer.put(getSlotCount());
+    writer.put(checkpointTimestamp);
+    for (const auto& chain : dataStore) {
+        EpochGuard guard;
+        const VersionBlock* block = chain.load();
+        uint32_t count = block ? static_cast<uint32_t>(block->size()) : 0;
+        writer.put(count);
+        if (count > 0) {
+            writer.putArray(block->commitTimestamps.get(), count);
+            writer.putArray(block->values.get(), count);
         }
     }
+    writer.commit(checkpointPath);
     
-    return result;
+    log->truncate();
+}
+
+void DataManager::syncLog() {
+    if (log) {
+        log->sync();
+    }
 }
 
-void DataManager::writeVariable(int variableId, int value, const std::string& transactionId) {
-    writeBuffer[transactionId][variableId] = value;
+VersionView DataManager::readVariable(int variableId, int snapshotTime) const {
+    if (!isReplicaReadable(variableId)) {
+        return VersionView();  
+    }
+    
+    return findVersionAt(variableId, snapshotTime);
+}
+
+VersionView DataManager::findVersionAt(int variableId, int snapshotTime) const {
+    int slot = slotOf(variableId);
+    if (slot < 0) {
+        return VersionView();
+    }
+    
+    return findInChain(dataStore[slot], snapshotTime);
 }
 
-void DataManager::commitWrites(const std::string& transactionId, int commitTimestamp) {
-    if (writeBuffer.find(transactionId) == writeBuffer.end()) {
+void DataManager::writeVariable(int variableId, int value, TxnId transactionId,
+                                std::pmr::memory_resource* arena) {
+    FlatMap<int, int>*& writes = writeBuffer[transactionId];
+    if (!writes) {
+        writes = newWriteBuffer(arena);
+    }
+    (*writes)[variableId] = value;
+}
+
+void DataManager::commitWrites(TxnId transactionId, int commitTimestamp) {
+    auto buffered = writeBuffer.find(transactionId);
+    if (buffered == writeBuffer.end()) {
         return;  
     }
     
-    auto& writes = writeBuffer[transactionId];
+    const auto& writes = *buffered->second;
+    
+    if (log) {
+        log->appendCommit(commitTimestamp, writes);
+    }
     
     for (const auto& [variableId, value] : writes) {
-        dataStore[variableId].push_back(Version(value, commitTimestamp, transactionId));
+        int slot = slotOf(variableId);
+        if (slot < 0) {
+            continue;
+        }
+        
+        dataStore[slot].append(Version(value, commitTimestamp, transactionId));
+        markForGc(slot);
         
         if (isReplicatedVariable(variableId)) {
-            replicaReadEnabled[variableId] = true;
+            replicaReadEpoch[slot].store(recoveryEpoch.load(std::memory_order_relaxed), 
+                                         std::memory_order_release);
         }
     }
     
-    writeBuffer.erase(transactionId);
+    deleteWriteBuffer(buffered->second);
+    writeBuffer.erase(buffered);
 }
 
-void DataManager::abortWrites(const std::string& transactionId) {
-    writeBuffer.erase(transactionId);
+void DataManager::abortWrites(TxnId transactionId) {
+    auto buffered = writeBuffer.find(transactionId);
+    if (buffered != writeBuffer.end()) {
+        deleteWriteBuffer(buffered->second);
+        writeBuffer.erase(buffered);
+    }
+}
+
+int DataManager::collectGarbage(int lowWaterMark) {
+    int reclaimed = 0;
+    size_t kept = 0;
+    
+    for (int slot : gcCandidates) {
+        VersionChain& chain = dataStore[slot];
+        
+        // Newest version visible at the watermark; everything before it is dead
+        VersionView newest = findInChain(chain, lowWaterMark);
+        if (newest && newest.getIndex() > 0) {
+            int count = newest.getIndex();
+            chain.eraseOldest(count);
+            reclaimed += count;
+            reclaimedBytes += static_cast<long long>(count) * VersionChain::BYTES_PER_VERSION;
+        }
+        
+        // Versions newer than the watermark become prunable once it advances
+        if (chain.size() > 1) {
+            gcCandidates[kept++] = slot;
+        } else {
+            gcPending[slot] = 0;
+        }
+    }
+    gcCandidates.resize(kept);
+    
+    reclaimedVersionCount += reclaimed;
+    return reclaimed;
 }
 
 void DataManager::onFailure() {
     isUp = false;
+    for (const auto& [transactionId, writes] : writeBuffer) {
+        deleteWriteBuffer(writes);
+    }
     writeBuffer.clear();
+    
+    if (log) {
+        for (auto& chain : dataStore) {
+            chain.clear();
+        }
+    }
 }
 
 void DataManager::onRecovery(int currentTime) {
+    if (log) {
+        reloadFromDisk();
+    }
+    
     isUp = true;
     lastRecoveryTime = currentTime;
+    recoveryEpoch.fetch_add(1, std::memory_order_release);
+}
+
+std::vector<std::pair<int, int>> DataManager::getCommittedState() const {
+    std::vector<std::pair<int, int>> state;
+    
+    std::vector<VersionChain> durable;
+    if (!isUp && log) {
+        long long replayedRecords = 0;
+        durable = loadDurableState(replayedRecords);
+    }
+    const auto& store = durable.empty() ? dataStore : durable;
     
-    for (int varId = 1; varId <= NUM_VARIABLES; varId++) {
-        if (isReplicatedVariable(varId) && 
-            dataStore.find(varId) != dataStore.end()) {
-            replicaReadEnabled[varId] = false;
+    for (int variableId : getVariablesAtSite(siteId)) {
+        if (VersionView newest = newestInChain(store[slotOf(variableId)])) {
+            state.emplace_back(variableId, newest.value());
         }
     }
+    
+    return state;
 }
 
-std::map<int, int> DataManager::getCommittedState() const {
-    std::map<int, int> state;
+bool DataManager::hasCompleteHistory(int variableId) const {
+    if (!isReplicatedVariable(variableId)) {
+        return true;
+    }
     
-    for (const auto& [variableId, versions] : dataStore) {
-        if (!versions.empty()) {
-            state[variableId] = versions.back().value;
-        }
+    int slot = slotOf(variableId);
+    return slot >= 0 && replicaCompleteEpoch[slot] == recoveryEpoch.load(std::memory_order_relaxed);
+}
+
+void DataManager::forgetCompleteHistory() {
+    std::fill(replicaCompleteEpoch.begin(), replicaCompleteEpoch.end(), -1);
+}
+
+void DataManager::markHistoryIncomplete(int variableId) {
+    int slot = slotOf(variableId);
+    if (slot >= 0 && isReplicatedVariable(variableId)) {
+        replicaReadEpoch[slot].store(-1, std::memory_order_release);
+        replicaCompleteEpoch[slot] = -1;
+    }
+}
+
+std::vector<Version> DataManager::getVersionsAfter(int variableId, int afterTimestamp) const {
+    std::vector<Version> versions;
+    int slot = slotOf(variableId);
+    if (slot < 0) {
+        return versions;
     }
     
-    return state;
+    // Pinned like every read: a concurrent GC or reload may retire the block
+    // while the versions are being copied
+    EpochGuard guard;
+    const VersionBlock* block = dataStore[slot].load();
+    if (!block) {
+        return versions;
+    }
+    
+    const int* timestamps = block->commitTimestamps.get();
+    int count = block->size();
+    const int* first = std::upper_bound(timestamps, timestamps + count, afterTimestamp);
+    for (int i = static_cast<int>(first - timestamps); i < count; i++) {
+        versions.emplace_back(block->values[i], block->commitTimestamps[i], block->writers[i]);
+    }
+    return versions;
+}
+
+int DataManager::getLatestCommitTime(int variableId) const {
+    int slot = slotOf(variableId);
+    VersionView newest = slot >= 0 ? newestInChain(dataStore[slot]) : VersionView();
+    return newest ? newest.commitTimestamp() : -1;
+}
+
+void DataManager::applyCatchUp(int variableId, const std::vector<Version>& versions) {
+    int slot = slotOf(variableId);
+    if (slot < 0) {
+        return;
+    }
+    
+    if (log) {
+        log->appendCopiedVersions(variableId, versions);
+    }
+    
+    for (const Version& version : versions) {
+        dataStore[slot].append(version);
+    }
+    markForGc(slot);
+    
+    int epoch = recoveryEpoch.load(std::memory_order_relaxed);
+    replicaReadEpoch[slot].store(epoch, std::memory_order_release);
+    replicaCompleteEpoch[slot] = epoch;
 }
 
 bool DataManager::isReplicaReadable(int variableId) const {
@@ -111,12 +428,13 @@ bool DataManager::isReplicaReadable(int variableId) const {
         return true;  
     }
     
-    auto it = replicaReadEnabled.find(variableId);
-    if (it == replicaReadEnabled.end()) {
+    int slot = slotOf(variableId);
+    if (slot < 0) {
         return false;  
     }
     
-    return it->second;
+    return replicaReadEpoch[slot].load(std::memory_order_acquire) == 
+           recoveryEpoch.load(std::memory_order_acquire);
 }
 
 } 
\ No newline at end of file
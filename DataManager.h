@@ -8,10 +8,16 @@
 
 #include "Version.h"
 #include "Constants.h"
+#include "TransactionIdTable.h"
+#include "WriteAheadLog.h"
+#include "SnapshotFile.h"
+#include "FlatMap.h"
+#include <atomic>
 #include <vector>
 #include <map>
-#include <string>
 #include <memory>
+#include <memory_resource>
+#include <string>
 
 namespace RepCRec {
 
@@ -21,14 +27,83 @@ private:
     bool isUp;
     int lastRecoveryTime;
     
-    // Data storage: variableId -> list of versions (sorted by commitTimestamp)
-    std::map<int, std::vector<Version>> dataStore;
+    // Data storage: one version chain per storage slot (see getSlotAtSite()), 
+    // each sorted by commitTimestamp; an empty chain is a variable not stored here.
+    // Sized once; chains are swapped in place so lock-free readers stay valid.
+    std::vector<VersionChain> dataStore;
+    
+    // Slots whose chains may hold versions collectGarbage() can drop: appended 
+    // to since the last pass, or still holding more than one version after it. 
+    // gcPending[slot] is true iff the slot is in gcCandidates.
+    std::vector<int> gcCandidates;
+    std::vector<char> gcPending;
+    
+    // Queue a slot for the next collectGarbage() pass (no-op if queued)
+    void markForGc(int slot) {
+        if (!gcPending[slot]) {
+            gcPending[slot] = 1;
+            gcCandidates.push_back(slot);
+        }
+    }
+    
+    // Write buffers: transactionId -> (variableId -> value). Each inner map, 
+    // object and entries alike, lives in the writing transaction's arena, so 
+    // buffering writes takes nothing from the heap once the outer array has 
+    // grown to the number of live writers; a commit applies and logs the 
+    // inner map in a single contiguous pass
+    FlatMap<TxnId, FlatMap<int, int>*> writeBuffer;
     
-    // Write buffers: transactionId -> (variableId -> value)
-    std::map<std::string, std::map<int, int>> writeBuffer;
+    // Replicated variable read gates (for post-recovery reads): a gate is open 
+    // iff it was last opened in the current recovery epoch, so recovery closes 
+    // every gate at once by bumping the epoch. Atomic because lock-free 
+    // readers check gates while the committer opens them.
+    std::atomic<int> recoveryEpoch;
+    std::vector<std::atomic<int>> replicaReadEpoch;  // slot -> epoch gate was opened (-1 never)
     
-    // Replicated variable read gates (for post-recovery reads)
-    std::map<int, bool> replicaReadEnabled;
+    // slot -> epoch since which the chain holds every commit to the variable 
+    // (-1 never). Unlike the read gate, a write after recovery does not set it: 
+    // only initialization and catch-up leave no gap behind.
+    std::vector<int> replicaCompleteEpoch;
+    
+    // Storage slot of a variable at this site, or -1 if not stored here
+    int slotOf(int variableId) const {
+        return getSlotAtSite(variableId, siteId);
+    }
+    
+    // Version garbage collection statistics
+    long long reclaimedVersionCount;
+    long long reclaimedBytes;
+    
+    // Durable copy of every commit at this site; null when durability is OFF
+    std::unique_ptr<WriteAheadLog> log;
+    std::string checkpointPath;  // site<N>.ckpt next to the log
+    int lastLoggedTimestamp;     // Newest durable commit found at startup
+    
+    // Cost of the last reloadFromDisk(), for restart-time reporting
+    double lastLoadMicros;
+    long long lastReplayedRecords;
+    
+    /**
+     * loadDurableState - Rebuild committed versions from checkpoint + log tail
+     * Author: Archita Arora
+     * Input:
+     *   - replayedRecords (long long&): Set to the number of log records applied
+     * Output: vector<VersionChain> - One chain per slot, as after every logged 
+     *         commit had been applied to a freshly initialized site
+     * Description: Starts from the checkpoint file (mapped with mmap; its 
+     *              columns are copied straight into the chains) or, without 
+     *              one, from the initial versions (10×i at time 0). Then 
+     *              appends the logged writes newer than the checkpoint in log 
+     *              order, which is commit order, so chains stay sorted.
+     * Side Effects: 
+     *   - Reads the checkpoint and log files
+     *   - Throws std::runtime_error if a checkpoint exists but is corrupt or 
+     *     was written for a different catalog
+     */
+    std::vector<VersionChain> loadDurableState(long long& replayedRecords) const;
+    
+    // Replace dataStore with loadDurableState(), recording how long it took
+    void reloadFromDisk();
     
 public:
     // ========================================================================
@@ -39,19 +114,28 @@ public:
      * DataManager Constructor
      * Author: Aishwarya Anand
      * Input: 
-     *   - siteId (int): Site identifier (1-10)
+     *   - siteId (int): Site identifier (1..getNumSites())
+     *   - walConfig (WalConfig): Write-ahead log settings (default: no log)
      * Output: None (constructor)
      * Description: Creates a DataManager for the specified site, sets initial 
      *              state to UP, and calls initialize() to populate variables 
-     *              with their initial values.
+     *              with their initial values. With a log, replays it on top so 
+     *              a restarted process resumes from its last durable state.
      * Side Effects:
      *   - Sets siteId to the provided value
      *   - Sets isUp to true
      *   - Sets lastRecoveryTime to 0
      *   - Calls initialize() which populates dataStore with initial versions
-     *   - Sets replicaReadEnabled[x] = true for all even-indexed variables
+     *   - Opens the read gate of every replicated variable at this site
+     *   - Opens (and may repair) the site's log file when durability is on
      */
-    DataManager(int siteId);
+    DataManager(int siteId, const WalConfig& walConfig = WalConfig());
+    
+    // Releases the write buffers still held (their arenas must be alive)
+    ~DataManager();
+    
+    DataManager(const DataManager&) = delete;
+    DataManager& operator=(const DataManager&) = delete;
     
     // ========================================================================
     // INITIALIZATION
@@ -62,13 +146,13 @@ public:
      * Author: Archita Arora
      * Input: None
      * Output: None
-     * Description: Determines which variables belong to this site based on 
-     *              replication rules (odd variables at home site, even variables 
-     *              at all sites) and creates initial versions with values 10×i.
+     * Description: Asks the catalog which variables belong to this site 
+     *              (getVariablesAtSite(), which only visits this site's variables) 
+     *              and creates initial versions with values 10×i.
      * Side Effects:
-     *   - Populates dataStore with initial Version objects for each variable
+     *   - Populates dataStore with an initial version for each variable
      *   - Each version has value = 10×variableId, commitTimestamp = 0
-     *   - Sets replicaReadEnabled[x] = true for all replicated (even) variables
+     *   - Opens the read gate of every replicated variable at this site
      */
     void initialize();
     
@@ -82,17 +166,41 @@ public:
      * Input:
      *   - variableId (int): Variable to read (1-20)
      *   - snapshotTime (int): Timestamp for snapshot isolation
-     * Output: shared_ptr<Version> - Version object or nullptr if unavailable
+     * Output: VersionView - Copy of the visible version; empty (tests false) 
+     *         if unavailable
      * Description: Returns the latest version of the variable committed at or 
      *              before snapshotTime. For replicated variables, checks the 
-     *              read gate (replicaReadEnabled) and returns nullptr if closed.
+     *              read gate (isReplicaReadable) and returns an empty view if 
+     *              closed. Nothing is allocated or locked: the search pins an 
+     *              EpochGuard, copies the version out and unpins, so any 
+     *              number of threads may call this while one thread commits 
+     *              at the site, each finishing in a bounded number of steps. 
+     *              The TransactionManager reads this way directly, without 
+     *              going through the site's worker queue.
      * Side Effects: None (read-only operation)
-     * Note: Returns nullptr if:
+     * Note: Returns an empty view if:
      *   - Variable doesn't exist at this site
      *   - Replicated variable has closed read gate (post-recovery)
      *   - No version committed before or at snapshotTime
      */
-    std::shared_ptr<Version> readVariable(int variableId, int snapshotTime);
+    VersionView readVariable(int variableId, int snapshotTime) const;
+    
+    /**
+     * findVersionAt - Locate the snapshot-visible version of a variable
+     * Author: Archita Arora
+     * Input:
+     *   - variableId (int): Variable to look up
+     *   - snapshotTime (int): Timestamp for snapshot isolation
+     * Output: VersionView - Latest version with commitTimestamp <= snapshotTime,
+     *         or an empty view if the variable is not stored here or has no such 
+     *         version
+     * Description: Binary search (upper_bound) over the chain's timestamp column, 
+     *              which is kept sorted. Ignores the replica read gate, so callers 
+     *              that need it must check isReplicaReadable() themselves. Safe 
+     *              to call concurrently with a commit, like readVariable().
+     * Side Effects: None (read-only operation)
+     */
+    VersionView findVersionAt(int variableId, int snapshotTime) const;
     
     // ========================================================================
     // WRITE OPERATIONS
@@ -104,7 +212,9 @@ public:
      * Input:
      *   - variableId (int): Variable to write (1-20)
      *   - value (int): Value to write
-     *   - transactionId (string): Transaction performing the write
+     *   - transactionId (TxnId): Transaction performing the write
+     *   - arena (memory_resource*): Allocator for the transaction's buffer at 
+     *                               this site; must outlive the buffered writes
      * Output: None
      * Description: Stores the write in a temporary buffer without modifying the 
      *              committed dataStore. The write will be applied only if the 
@@ -113,31 +223,35 @@ public:
      *   - Adds entry to writeBuffer[transactionId][variableId] = value
      *   - Does NOT modify dataStore (committed versions)
      */
-    void writeVariable(int variableId, int value, const std::string& transactionId);
+    void writeVariable(int variableId, int value, TxnId transactionId,
+                       std::pmr::memory_resource* arena = std::pmr::get_default_resource());
     
     /**
      * commitWrites - Persist buffered writes to committed storage
      * Author: Aishwarya Anand
      * Input:
-     *   - transactionId (string): Transaction to commit
+     *   - transactionId (TxnId): Transaction to commit
      *   - commitTimestamp (int): Commit time for new versions
      * Output: None
      * Description: Moves all buffered writes for the transaction from writeBuffer 
      *              to dataStore as new committed versions. Opens read gate for 
-     *              replicated variables that receive writes.
+     *              replicated variables that receive writes. With a log, the 
+     *              commit record is appended (and synced per the durability 
+     *              level) before any version is installed.
      * Side Effects:
-     *   - Creates new Version objects in dataStore with commitTimestamp
-     *   - Sets replicaReadEnabled[x] = true for each replicated variable written
+     *   - Appends one record to the site's log when durability is on
+     *   - Appends new versions to the dataStore chains with commitTimestamp
+     *   - Opens the read gate of each replicated variable written
      *   - Removes transaction's entries from writeBuffer
      *   - Versions are appended to dataStore in chronological order
      */
-    void commitWrites(const std::string& transactionId, int commitTimestamp);
+    void commitWrites(TxnId transactionId, int commitTimestamp);
     
     /**
      * abortWrites - Discard buffered writes for a transaction
      * Author: Archita Arora
      * Input:
-     *   - transactionId (string): Transaction to abort
+     *   - transactionId (TxnId): Transaction to abort
      * Output: None
      * Description: Removes all buffered writes for the transaction without 
      *              modifying committed data.
@@ -145,7 +259,36 @@ public:
      *   - Removes transaction's entries from writeBuffer
      *   - Does NOT modify dataStore (no changes to committed versions)
      */
-    void abortWrites(const std::string& transactionId);
+    void abortWrites(TxnId transactionId);
+    
+    // ========================================================================
+    // GARBAGE COLLECTION
+    // ========================================================================
+    
+    /**
+     * collectGarbage - Prune versions no snapshot can observe anymore
+     * Author: Aishwarya Anand
+     * Input:
+     *   - lowWaterMark (int): Oldest startTime among live transactions (or the
+     *                         current timestamp when none are live)
+     * Output: int - Number of versions reclaimed at this site
+     * Description: For each queued chain (see gcCandidates), keeps the newest 
+     *              version committed at or before lowWaterMark plus every newer 
+     *              version, and drops the rest. A chain left with a single 
+     *              version leaves the queue until its next append, so a pass 
+     *              costs the chains written since the last one rather than the 
+     *              whole store. Every present or future snapshot is taken at or after 
+     *              lowWaterMark, so the dropped versions can never be returned by 
+     *              readVariable() nor consulted by computeValidSnapshotSites(). 
+     *              The kept version's commitTimestamp is the lower bound of any 
+     *              wasUpContinuously() check, so it is preserved as-is.
+     * Side Effects:
+     *   - Moves surviving versions to a new block (shrunk once the chain is 
+     *     well below its capacity) and retires the old one
+     *   - Updates reclaimedVersionCount and reclaimedBytes
+     *   - Shrinks gcCandidates to the chains that still hold older versions
+     */
+    int collectGarbage(int lowWaterMark);
     
     // ========================================================================
     // FAILURE AND RECOVERY
@@ -157,11 +300,14 @@ public:
      * Input: None
      * Output: None
      * Description: Marks the site as down and discards all uncommitted writes. 
-     *              Committed data remains intact for when the site recovers.
+     *              Without a log, committed data remains intact in memory for 
+     *              when the site recovers. With a log, the site loses its memory 
+     *              like a crashed process, and committed data survives only on 
+     *              disk.
      * Side Effects:
      *   - Sets isUp = false
      *   - Clears entire writeBuffer (all uncommitted writes are lost)
-     *   - dataStore (committed versions) remains unchanged
+     *   - With a log, empties every chain in dataStore
      */
     void onFailure();
     
@@ -173,12 +319,14 @@ public:
      * Output: None
      * Description: Marks the site as up and implements the read gate mechanism 
      *              for replicated variables to prevent stale reads. Unreplicated 
-     *              variables are immediately readable.
+     *              variables are immediately readable. With a log, committed 
+     *              data is first rebuilt by replaying it.
      * Side Effects:
+     *   - With a log, replaces dataStore with loadDurableState()
      *   - Sets isUp = true
      *   - Sets lastRecoveryTime = currentTime
-     *   - For all replicated (even-indexed) variables at this site:
-     *       Sets replicaReadEnabled[x] = false (closes read gate)
+     *   - Increments recoveryEpoch, which closes the read gate of every 
+     *     replicated variable at this site in O(1)
      *   - Unreplicated variables remain immediately readable
      *   - Read gates will be opened when new writes commit
      */
@@ -192,12 +340,131 @@ public:
      * getCommittedState - Get current committed values for dump
      * Author: Aishwarya Anand
      * Input: None
-     * Output: Map<int, int> - variableId → latest committed value
+     * Output: vector<pair<int, int>> - (variableId, latest committed value) in 
+     *         ascending variableId order
      * Description: Returns the most recent committed value of each variable 
-     *              stored at this site. Used by the dump() command.
+     *              stored at this site. Used by the dump() command. A down site 
+     *              with a log reports its durable state from disk.
+     * Side Effects: None (read-only operation)
+     */
+    std::vector<std::pair<int, int>> getCommittedState() const;
+    
+    /**
+     * checkpoint - Snapshot this site's committed versions and trim its log
+     * Author: Aishwarya Anand
+     * Input: None
+     * Output: None
+     * Description: Writes every version currently held (i.e. already pruned to 
+     *              the GC low-water mark, so any live snapshot can still be 
+     *              served after a reload) to site<N>.ckpt, column by column 
+     *              (timestamps and values; writer ids are process-local and 
+     *              are not saved), stamped with the newest commit it covers. Once that file is 
+     *              durable the log is truncated, bounding the next replay to 
+     *              the commits since. Commits are applied one at a time, so the 
+     *              checkpoint is always transaction-consistent. No-op without 
+     *              a log or while the site is down (its memory is gone).
+     * Side Effects:
+     *   - Atomically replaces site<N>.ckpt, then truncates site<N>.wal
+     */
+    void checkpoint();
+    
+    /**
+     * syncLog - Force this site's logged commits to stable storage
+     * Author: Archita Arora
+     * Input: None
+     * Output: None
+     * Description: Closes the log's current commit group early (see 
+     *              WriteAheadLog::sync()), so the TransactionManager can 
+     *              acknowledge a group of commits across all sites at once. 
+     *              Also runs while the site is down, since its records were 
+     *              written before it failed. No-op without a log.
+     * Side Effects: May fsync site<N>.wal
+     */
+    void syncLog();
+    
+    // ========================================================================
+    // CATCH-UP (RecoveryMode::CATCH_UP)
+    // ========================================================================
+    
+    /**
+     * hasCompleteHistory - Check that no commit to a variable is missing here
+     * Author: Archita Arora
+     * Input:
+     *   - variableId (int): Variable to check
+     * Output: Boolean - true if the chain holds every commit to the variable 
+     *         (up to GC) since this site last recovered, or since startup
+     * Description: True for unreplicated variables. For replicated ones, true 
+     *              until the next recovery unless catch-up refills the chain.
+     *              Such a site can serve any snapshot of the variable, 
+     *              whatever its failure history.
      * Side Effects: None (read-only operation)
      */
-    std::map<int, int> getCommittedState() const;
+    bool hasCompleteHistory(int variableId) const;
+    
+    /**
+     * forgetCompleteHistory - Treat every replicated chain as possibly gapped
+     * Author: Aishwarya Anand
+     * Input: None
+     * Output: None
+     * Description: Used after a restart for a site that has failed before: 
+     *              the flags are not persisted, and a chain reopened by a write 
+     *              rather than by catch-up may miss versions.
+     * Side Effects: Clears replicaCompleteEpoch
+     */
+    void forgetCompleteHistory();
+    
+    /**
+     * markHistoryIncomplete - Record that this site missed a commit
+     * Author: Archita Arora
+     * Input:
+     *   - variableId (int): Replicated variable that was committed elsewhere
+     * Output: None
+     * Description: Called when a commit skips this (up) site because it was 
+     *              down when the transaction wrote the variable. The local 
+     *              chain is now stale, so the gate closes until catch-up.
+     * Side Effects: Closes the read gate and clears the complete flag for the slot
+     */
+    void markHistoryIncomplete(int variableId);
+    
+    /**
+     * getVersionsAfter - Delta of committed versions for a catching-up peer
+     * Author: Aishwarya Anand
+     * Input:
+     *   - variableId (int): Variable to copy
+     *   - afterTimestamp (int): Only versions committed later are returned
+     * Output: vector<Version> - Versions oldest first (empty if none or the 
+     *         variable is not stored here)
+     * Side Effects: None (read-only operation)
+     */
+    std::vector<Version> getVersionsAfter(int variableId, int afterTimestamp) const;
+    
+    /**
+     * getLatestCommitTime - Commit time of the newest local version
+     * Author: Archita Arora
+     * Input:
+     *   - variableId (int): Variable to check
+     * Output: int - commitTimestamp, or -1 if the variable is not stored here
+     * Side Effects: None (read-only operation)
+     */
+    int getLatestCommitTime(int variableId) const;
+    
+    /**
+     * applyCatchUp - Install versions copied from an up-to-date peer
+     * Author: Aishwarya Anand
+     * Input:
+     *   - variableId (int): Replicated variable being caught up
+     *   - versions (vector<Version>): Peer versions newer than 
+     *                                 getLatestCommitTime(), oldest first
+     * Output: None
+     * Description: Logs the copies (when a log exists), appends them to the 
+     *              chain, then reopens the variable's read gate and marks its 
+     *              history complete. The caller must take the delta from a 
+     *              site that is up and hasCompleteHistory() for the variable.
+     * Side Effects:
+     *   - Appends to dataStore and the log
+     *   - Opens the read gate and sets replicaCompleteEpoch for the slot
+     */
+    void applyCatchUp(int variableId, const std::vector<Version>& versions);
     
     /**
      * isReplicaReadable - Check if replicated variable is readable
@@ -241,19 +508,60 @@ public:
     }
     
     /**
-     * getDataStore - Get direct access to version history
+     * getReclaimedVersionCount - Total versions pruned by collectGarbage()
      * Author: Aishwarya Anand
      * Input: None
-     * Output: Reference to map<int, vector<Version>> - dataStore
-     * Description: Provides direct access to the dataStore for snapshot 
-     *              validation in TransactionManager. Used by 
-     *              computeValidSnapshotSites() to check version timestamps 
-     *              and continuous site availability.
-     * Side Effects: None (returns reference, but used read-only by caller)
-     * Note: This is a convenience method to avoid copying large version histories
+     * Output: long long - Number of versions reclaimed since construction
+     * Side Effects: None (read-only inline getter)
      */
-    std::map<int, std::vector<Version>>& getDataStore() { 
-        return dataStore; 
+    long long getReclaimedVersionCount() const {
+        return reclaimedVersionCount;
+    }
+    
+    /**
+     * getReclaimedBytes - Total memory released by collectGarbage()
+     * Author: Archita Arora
+     * Input: None
+     * Output: long long - Bytes reclaimed since construction
+     * Side Effects: None (read-only inline getter)
+     */
+    long long getReclaimedBytes() const {
+        return reclaimedBytes;
+    }
+    
+    /**
+     * getLastLoggedTimestamp - Newest commit replayed from the log at startup
+     * Author: Aishwarya Anand
+     * Input: None
+     * Output: int - Commit timestamp, or 0 if there was no log or it was empty
+     * Description: Lets the TransactionManager resume its clock after the 
+     *              durable history of a previous run.
+     * Side Effects: None (read-only inline getter)
+     */
+    int getLastLoggedTimestamp() const {
+        return lastLoggedTimestamp;
+    }
+    
+    /**
+     * getLastLoadMicros - Wall time of the last durable-state load
+     * Author: Archita Arora
+     * Input: None
+     * Output: double - Microseconds spent in the latest startup or recovery 
+     *         load (checkpoint map + log tail replay), 0 without a log
+     * Side Effects: None (read-only inline getter)
+     */
+    double getLastLoadMicros() const {
+        return lastLoadMicros;
+    }
+    
+    // Log records applied by the latest startup or recovery load
+    long long getLastReplayedRecords() const {
+        return lastReplayedRecords;
+    }
+    
+    // Bytes currently in this site's log (0 without a log)
+    long long getLogSizeBytes() const {
+        return log ? log->getSizeBytes() : 0;
     }
 };
 
@@ -0,0 +1,124 @@
+// EpochReclaimer.cpp
+// Author: Aishwarya and Archita
+// Date: December 2025
+// Purpose: Implementation of epoch-based reclamation
+
+#include "EpochReclaimer.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace RepCRec {
+
+namespace {
+
+// Per-thread reader registration in the global domain
+struct ThreadReader {
+    std::atomic<bool>* claimed = nullptr;
+    void* slot = nullptr;
+    int depth = 0;
+
+    ~ThreadReader() {
+        if (claimed) {
+            claimed->store(false, std::memory_order_release);
+        }
+    }
+};
+
+thread_local ThreadReader threadReader;
+
+}
+
+EpochDomain::EpochDomain() : globalEpoch(1), reclaimAt(EPOCH_RECLAIM_BATCH) {}
+
+EpochDomain::~EpochDomain() {
+    for (const Retired& entry : retired) {
+        entry.destroy(entry.object);
+    }
+}
+
+EpochDomain& EpochDomain::global() {
+    static EpochDomain domain;
+    return domain;
+}
+
+EpochDomain::ReaderSlot& EpochDomain::localSlot() {
+    if (threadReader.slot) {
+        return *static_cast<ReaderSlot*>(threadReader.slot);
+    }
+
+    for (ReaderSlot& candidate : readers) {
+        bool expected = false;
+        if (candidate.claimed.compare_exchange_strong(expected, true, 
+                                                      std::memory_order_acq_rel)) {
+            threadReader.claimed = &candidate.claimed;
+            threadReader.slot = &candidate;
+            return candidate;
+        }
+    }
+    throw std::runtime_error("More than " + std::to_string(MAX_EPOCH_READERS) + 
+                             " threads reading version chains");
+}
+
+void EpochDomain::retireErased(void* object, void (*destroy)(void*)) {
+    std::lock_guard<std::mutex> lock(retiredMutex);
+    // Pairs with the fence in EpochGuard: either the reader's pin is visible 
+    // below, or the reader's next load sees the pointer that replaced object
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t epoch = globalEpoch.fetch_add(1, std::memory_order_acq_rel);
+    retired.push_back({ epoch, object, destroy });
+    
+    // Objects still pinned after a scan do not trigger the next one, so a 
+    // long-lived reader cannot turn every retire back into a full scan
+    if (retired.size() >= reclaimAt) {
+        reclaimLocked();
+        reclaimAt = retired.size() + EPOCH_RECLAIM_BATCH;
+    }
+}
+
+void EpochDomain::reclaimLocked() {
+    uint64_t oldestPinned = UINT64_MAX;
+    for (const ReaderSlot& reader : readers) {
+        uint64_t pinned = reader.epoch.load(std::memory_order_acquire);
+        if (pinned != 0) {
+            oldestPinned = std::min(oldestPinned, pinned);
+        }
+    }
+
+    // A reader pinned at epoch e loaded the global epoch after every object
+    // retired before e was unlinked, so it cannot hold any of them
+    auto firstLive = std::partition(retired.begin(), retired.end(), 
+                                    [oldestPinned](const Retired& entry) {
+        return entry.epoch < oldestPinned;
+    });
+    for (auto it = retired.begin(); it != firstLive; ++it) {
+        it->destroy(it->object);
+    }
+    retired.erase(retired.begin(), firstLive);
+}
+
+size_t EpochDomain::getPendingCount() {
+    std::lock_guard<std::mutex> lock(retiredMutex);
+    return retired.size();
+}
+
+EpochGuard::EpochGuard() : slot(nullptr) {
+    if (threadReader.depth++ > 0) {
+        return;
+    }
+
+    EpochDomain& domain = EpochDomain::global();
+    slot = &domain.localSlot();
+    slot->epoch.store(domain.globalEpoch.load(std::memory_order_acquire), 
+                      std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+EpochGuard::~EpochGuard() {
+    threadReader.depth--;
+    if (slot) {
+        slot->epoch.store(0, std::memory_order_release);
+    }
+}
+
+}
@@ -0,0 +1,114 @@
+// EpochReclaimer.h
+// Author: Aishwarya and Archita
+// Date: December 2025
+// Purpose: Epoch-based reclamation of memory that lock-free readers may still
+//          be looking at (retired version blocks)
+// Side effects: Frees retired objects once no reader can reach them
+
+#ifndef EPOCHRECLAIMER_H
+#define EPOCHRECLAIMER_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace RepCRec {
+
+// Maximum number of threads that may hold an EpochGuard at the same time
+const int MAX_EPOCH_READERS = 256;
+
+// Retirements between scans of the reader slots
+const size_t EPOCH_RECLAIM_BATCH = 64;
+
+class EpochDomain {
+private:
+    // One reader's pinned epoch (0 = not reading), alone on its cache line
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch{0};
+        std::atomic<bool> claimed{false};
+    };
+
+    struct Retired {
+        uint64_t epoch;
+        void* object;
+        void (*destroy)(void*);
+    };
+
+    std::atomic<uint64_t> globalEpoch;
+    ReaderSlot readers[MAX_EPOCH_READERS];
+
+    // Writers retire rarely (chain growth, GC, reload), so a mutex is fine
+    std::mutex retiredMutex;
+    std::vector<Retired> retired;
+    size_t reclaimAt;  // Scan once retired reaches this size
+
+    friend class EpochGuard;
+
+    // This thread's slot, claimed on first use and released at thread exit
+    ReaderSlot& localSlot();
+
+    void reclaimLocked();
+
+public:
+    EpochDomain();
+    ~EpochDomain();
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    // Process-wide domain shared by every DataManager
+    static EpochDomain& global();
+
+    /**
+     * retire - Hand over an object that has just been unlinked
+     * Author: Archita Arora
+     * Input:
+     *   - object (T*): No longer reachable from any shared pointer; readers
+     *                  that loaded it before the unlink may still use it
+     * Output: None
+     * Description: Stamps the object with the current epoch and advances the
+     *              epoch. It is deleted once every pinned reader has pinned a
+     *              later epoch, i.e. once no reader can still hold it. The
+     *              reader slots are scanned once per EPOCH_RECLAIM_BATCH
+     *              retirements (counted from what the last scan left behind),
+     *              not on every call.
+     * Side Effects:
+     *   - Every EPOCH_RECLAIM_BATCH calls, deletes the retired objects no 
+     *     reader can reach
+     */
+    template <typename T>
+    void retire(T* object) {
+        if (object) {
+            retireErased(object, [](void* p) { delete static_cast<T*>(p); });
+        }
+    }
+
+    void retireErased(void* object, void (*destroy)(void*));
+
+    // Objects retired but not yet freed
+    size_t getPendingCount();
+};
+
+/**
+ * EpochGuard - Pins the calling thread's epoch for its lifetime
+ * Description: While a guard is alive, nothing the thread loads from a
+ *              published pointer is freed. Entering and leaving are a
+ *              couple of atomic operations and never wait. Guards nest.
+ *              Guards pin the global domain.
+ */
+class EpochGuard {
+private:
+    EpochDomain::ReaderSlot* slot;
+
+public:
+    EpochGuard();
+    ~EpochGuard();
+
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+}
+
+#endif
@@ -0,0 +1,318 @@
+// EventSink.cpp
+// Author: Aishwarya and Archita
+// Date: December 2025
+// Purpose: Implementation of the event sinks
+
+#include "EventSink.h"
+
+namespace RepCRec {
+
+namespace {
+
+const char* eventName(EventType type) {
+    switch (type) {
+        case EventType::BEGIN:                 return "begin";
+        case EventType::READ:                  return "read";
+        case EventType::READ_OWN_WRITE:        return "read_own_write";
+        case EventType::WRITE:                 return "write";
+        case EventType::COMMIT:                return "commit";
+        case EventType::ABORT:                 return "abort";
+        case EventType::WAIT_SITE_DOWN:        return "wait_site_down";
+        case EventType::WAIT_NO_VALID_SITE:    return "wait_no_valid_site";
+        case EventType::STILL_WAITING:         return "still_waiting";
+        case EventType::RETRY:                 return "retry";
+        case EventType::SITE_FAIL:             return "site_fail";
+        case EventType::SITE_RECOVER:          return "site_recover";
+        case EventType::SITE_CATCH_UP:         return "site_catch_up";
+        case EventType::DUMP:                  return "dump";
+        case EventType::TRANSACTION_NOT_FOUND: return "transaction_not_found";
+        case EventType::NO_VERSION:            return "no_version";
+        case EventType::UNKNOWN_VARIABLE:      return "unknown_variable";
+        case EventType::COMMAND_ERROR:         return "command_error";
+    }
+    return "unknown";
+}
+
+void writeJsonString(std::ostream& out, const std::string& text) {
+    static const char* hex = "0123456789abcdef";
+    out << '"';
+    for (char c : text) {
+        unsigned char byte = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (byte < 0x20) {
+            out << "\\u00" << hex[byte >> 4] << hex[byte & 0xf];
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+}
+
+// ============================================================================
+// TEXT
+// ============================================================================
+
+void TextEventSink::emit(Event&& event) {
+    switch (event.type) {
+        case EventType::BEGIN:
+            out << "Transaction " << event.transaction << " begins at time " << event.time << '\n';
+            break;
+        case EventType::READ:
+            out << "x" << event.variable << ": " << event.value << '\n';
+            break;
+        case EventType::READ_OWN_WRITE:
+            out << "x" << event.variable << ": " << event.value << " (RYOW)\n";
+            break;
+        case EventType::WRITE:
+            out << "W(" << event.transaction << ", x" << event.variable << ", " << event.value
+                << ") -> sites:";
+            for (int siteId : event.sites) {
+                out << " " << siteId;
+            }
+            out << '\n';
+            break;
+        case EventType::COMMIT:
+            out << event.transaction << " commits\n";
+            break;
+        case EventType::ABORT:
+            out << event.transaction << " aborts (" << event.detail << ")\n";
+            break;
+        case EventType::WAIT_SITE_DOWN:
+            out << "Transaction " << event.transaction << " waits (site " << event.site
+                << " down)\n";
+            break;
+        case EventType::WAIT_NO_VALID_SITE:
+            out << "Transaction " << event.transaction << " waits (no valid site)\n";
+            break;
+        case EventType::STILL_WAITING:
+            out << "Transaction " << event.transaction << " is waiting\n";
+            break;
+        case EventType::RETRY:
+            out << "Retry: " << event.transaction << '\n';
+            break;
+        case EventType::SITE_FAIL:
+            out << "Site " << event.site << " fails\n";
+            break;
+        case EventType::SITE_RECOVER:
+            out << "Site " << event.site << " recovers\n";
+            break;
+        case EventType::SITE_CATCH_UP:
+            out << "Site " << event.site << " catches up " << event.count << "/" << event.total
+                << " replicated variables (" << event.value << " versions)\n";
+            break;
+        case EventType::DUMP:
+            out << "\n=== DUMP ===\n";
+            for (const SiteDump& row : event.dump) {
+                out << "site " << row.site << " - ";
+                bool first = true;
+                for (const auto& [varId, value] : row.values) {
+                    if (!first) out << ", ";
+                    out << "x" << varId << ": " << value;
+                    first = false;
+                }
+                out << '\n';
+            }
+            out << "============\n\n";
+            break;
+        case EventType::TRANSACTION_NOT_FOUND:
+            out << "Error: Transaction " << event.transaction << " not found\n";
+            break;
+        case EventType::NO_VERSION:
+            out << "Error: No version for x" << event.variable << '\n';
+            break;
+        case EventType::UNKNOWN_VARIABLE:
+            out << "Error: No variable x" << event.variable << " (catalog has x1..x"
+                << getNumVariables() << ")\n";
+            break;
+        case EventType::COMMAND_ERROR:
+            out << "Error: " << event.detail << '\n';
+            break;
+    }
+}
+
+void TextEventSink::flush() {
+    out.flush();
+}
+
+// ============================================================================
+// JSON LINES
+// ============================================================================
+
+void JsonLinesEventSink::emit(Event&& event) {
+    out << "{\"t\":" << event.time << ",\"event\":\"" << eventName(event.type) << '"';
+
+    switch (event.type) {
+        case EventType::BEGIN:
+        case EventType::COMMIT:
+        case EventType::STILL_WAITING:
+        case EventType::TRANSACTION_NOT_FOUND:
+            out << ",\"txn\":";
+            writeJsonString(out, event.transaction);
+            break;
+        case EventType::READ:
+            out << ",\"txn\":";
+            writeJsonString(out, event.transaction);
+            out << ",\"var\":" << event.variable << ",\"value\":" << event.value
+                << ",\"site\":" << event.site;
+            break;
+        case EventType::READ_OWN_WRITE:
+            out << ",\"txn\":";
+            writeJsonString(out, event.transaction);
+            out << ",\"var\":" << event.variable << ",\"value\":" << event.value;
+            break;
+        case EventType::WRITE: {
+            out << ",\"txn\":";
+            writeJsonString(out, event.transaction);
+            out << ",\"var\":" << event.variable << ",\"value\":" << event.value << ",\"sites\":[";
+            bool first = true;
+            for (int siteId : event.sites) {
+                out << (first ? "" : ",") << siteId;
+                first = false;
+            }
+            out << ']';
+            break;
+        }
+        case EventType::ABORT:
+            out << ",\"txn\":";
+            writeJsonString(out, event.transaction);
+            out << ",\"reason\":";
+            writeJsonString(out, event.detail);
+            break;
+        case EventType::WAIT_SITE_DOWN:
+            out << ",\"txn\":";
+            writeJsonString(out, event.transaction);
+            out << ",\"var\":" << event.variable << ",\"site\":" << event.site;
+            break;
+        case EventType::WAIT_NO_VALID_SITE:
+        case EventType::RETRY:
+            out << ",\"txn\":";
+            writeJsonString(out, event.transaction);
+            out << ",\"var\":" << event.variable;
+            break;
+        case EventType::SITE_FAIL:
+        case EventType::SITE_RECOVER:
+            out << ",\"site\":" << event.site;
+            break;
+        case EventType::SITE_CATCH_UP:
+            out << ",\"site\":" << event.site << ",\"caught_up\":" << event.count
+                << ",\"replicated\":" << event.total << ",\"versions\":" << event.value;
+            break;
+        case EventType::DUMP:
+            out << ",\"sites\":{";
+            for (size_t i = 0; i < event.dump.size(); i++) {
+                out << (i ? "," : "") << '"' << event.dump[i].site << "\":{";
+                bool first = true;
+                for (const auto& [varId, value] : event.dump[i].values) {
+                    out << (first ? "" : ",") << "\"x" << varId << "\":" << value;
+                    first = false;
+                }
+                out << '}';
+            }
+            out << '}';
+            break;
+        case EventType::NO_VERSION:
+        case EventType::UNKNOWN_VARIABLE:
+            out << ",\"var\":" << event.variable;
+            break;
+        case EventType::COMMAND_ERROR:
+            out << ",\"message\":";
+            writeJsonString(out, event.detail);
+            break;
+    }
+    out << "}\n";
+}
+
+void JsonLinesEventSink::flush() {
+    out.flush();
+}
+
+// ============================================================================
+// BACKGROUND
+// ============================================================================
+
+BackgroundEventSink::BackgroundEventSink(std::unique_ptr<EventSink> sink)
+    : target(std::move(sink)), writing(false), stopping(false) {
+    worker = std::thread([this] { writerLoop(); });
+}
+
+BackgroundEventSink::~BackgroundEventSink() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    ready.notify_one();
+    worker.join();
+}
+
+void BackgroundEventSink::writerLoop() {
+    std::vector<Event> batch;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        ready.wait(lock, [this] { return stopping || !pending.empty(); });
+        if (pending.empty()) {
+            return;
+        }
+
+        batch.swap(pending);
+        writing = true;
+        lock.unlock();
+
+        for (Event& event : batch) {
+            target->emit(std::move(event));
+        }
+        target->flush();
+        batch.clear();
+
+        lock.lock();
+        writing = false;
+        if (pending.empty()) {
+            drained.notify_all();
+        }
+    }
+}
+
+void BackgroundEventSink::emit(Event&& event) {
+    bool wasEmpty;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        wasEmpty = pending.empty();
+        pending.push_back(std::move(event));
+    }
+    // A non-empty queue means the writer is already awake or about to be
+    if (wasEmpty) {
+        ready.notify_one();
+    }
+}
+
+void BackgroundEventSink::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    drained.wait(lock, [this] { return pending.empty() && !writing; });
+}
+
+// ============================================================================
+// FACTORY
+// ============================================================================
+
+std::unique_ptr<EventSink> makeEventSink(OutputFormat format, std::ostream& output,
+                                         bool background) {
+    std::unique_ptr<EventSink> sink;
+    switch (format) {
+        case OutputFormat::TEXT:
+            sink = std::make_unique<TextEventSink>(output);
+            break;
+        case OutputFormat::JSON_LINES:
+            sink = std::make_unique<JsonLinesEventSink>(output);
+            break;
+        case OutputFormat::NONE:
+            return std::make_unique<NullEventSink>();
+    }
+    if (background) {
+        return std::make_unique<BackgroundEventSink>(std::move(sink));
+    }
+    return sink;
+}
+
+}
@@ -0,0 +1,169 @@
+// EventSink.h
+// Author: Aishwarya and Archita
+// Date: December 2025
+// Purpose: Structured events reported by the TransactionManager, and the
+//          sinks that render them (text, JSON lines, none), optionally on a
+//          background thread
+// Side effects: Sinks write to an output stream; BackgroundEventSink starts
+//               and joins one thread
+
+#ifndef EVENTSINK_H
+#define EVENTSINK_H
+
+#include "Constants.h"
+#include "SiteSet.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace RepCRec {
+
+enum class EventType {
+    BEGIN,                  // transaction, time
+    READ,                   // transaction, variable, value, site
+    READ_OWN_WRITE,         // transaction, variable, value
+    WRITE,                  // transaction, variable, value, sites
+    COMMIT,                 // transaction
+    ABORT,                  // transaction, detail (reason)
+    WAIT_SITE_DOWN,         // transaction, variable, site
+    WAIT_NO_VALID_SITE,     // transaction, variable
+    STILL_WAITING,          // transaction (operation ignored)
+    RETRY,                  // transaction, variable
+    SITE_FAIL,              // site
+    SITE_RECOVER,           // site
+    SITE_CATCH_UP,          // site, count/total replicated variables, value (versions)
+    DUMP,                   // dump
+    TRANSACTION_NOT_FOUND,  // transaction
+    NO_VERSION,             // variable
+    UNKNOWN_VARIABLE,       // variable (outside the catalog; operation ignored)
+    COMMAND_ERROR           // detail (malformed script line)
+};
+
+// Committed values at one site, as printed by dump
+struct SiteDump {
+    int site;
+    std::vector<std::pair<int, int>> values;  // (variableId, value)
+};
+
+// One reported occurrence. Only the fields listed for its type are set.
+struct Event {
+    EventType type;
+    int time = 0;  // Logical time when the event was reported
+    int site = 0;
+    int variable = 0;
+    int value = 0;
+    int count = 0;
+    int total = 0;
+    SiteSet sites;
+    std::string transaction;
+    std::string detail;
+    std::vector<SiteDump> dump;
+
+    Event(EventType eventType, int eventTime) : type(eventType), time(eventTime) {}
+};
+
+class EventSink {
+public:
+    virtual ~EventSink() = default;
+
+    // Deliver one event; called from the TransactionManager's thread only
+    virtual void emit(Event&& event) = 0;
+
+    // Return once every event emitted so far has been written out
+    virtual void flush() {}
+};
+
+// The original console output, one line per event
+class TextEventSink : public EventSink {
+private:
+    std::ostream& out;
+
+public:
+    explicit TextEventSink(std::ostream& output) : out(output) {}
+
+    void emit(Event&& event) override;
+    void flush() override;
+};
+
+// {"t":5,"event":"read","txn":"T1","var":4,"value":40,"site":2} per line
+class JsonLinesEventSink : public EventSink {
+private:
+    std::ostream& out;
+
+public:
+    explicit JsonLinesEventSink(std::ostream& output) : out(output) {}
+
+    void emit(Event&& event) override;
+    void flush() override;
+};
+
+// Drops everything; lets benchmarks measure the engine without formatting
+class NullEventSink : public EventSink {
+public:
+    void emit(Event&&) override {}
+};
+
+/**
+ * BackgroundEventSink - Hands events to another sink on its own thread
+ * Description: emit() only appends to a queue, so the TransactionManager
+ *              never waits for formatting or for stdout. The thread takes
+ *              the whole queue at once and writes it in order, flushing the
+ *              target once per batch. Event order is preserved.
+ */
+class BackgroundEventSink : public EventSink {
+private:
+    std::unique_ptr<EventSink> target;
+    std::mutex mutex;
+    std::condition_variable ready;    // Events queued, or stopping
+    std::condition_variable drained;  // Queue empty and no batch in progress
+    std::vector<Event> pending;
+    bool writing;
+    bool stopping;
+    std::thread worker;
+
+    void writerLoop();
+
+public:
+    /**
+     * BackgroundEventSink Constructor
+     * Author: Archita Arora
+     * Input:
+     *   - sink (unique_ptr<EventSink>): Sink that does the writing; from now
+     *                                   on only the background thread uses it
+     * Output: None (constructor)
+     * Side Effects: Starts the writer thread
+     */
+    explicit BackgroundEventSink(std::unique_ptr<EventSink> sink);
+
+    // Writes out everything still queued, then joins the thread
+    ~BackgroundEventSink() override;
+
+    BackgroundEventSink(const BackgroundEventSink&) = delete;
+    BackgroundEventSink& operator=(const BackgroundEventSink&) = delete;
+
+    void emit(Event&& event) override;
+    void flush() override;
+};
+
+/**
+ * makeEventSink - Build the sink for an output format
+ * Author: Aishwarya Anand
+ * Input:
+ *   - format (OutputFormat): TEXT, JSON_LINES or NONE
+ *   - output (ostream&): Where TEXT and JSON_LINES write
+ *   - background (bool): Write on a BackgroundEventSink thread (ignored
+ *                        for NONE, which has nothing to write)
+ * Output: unique_ptr<EventSink> - The new sink
+ * Side Effects: May start a thread
+ */
+std::unique_ptr<EventSink> makeEventSink(OutputFormat format, std::ostream& output,
+                                         bool background);
+
+}
+
+#endif
@@ -0,0 +1,103 @@
+// FlatMap.h
+// Author: Aishwarya and Archita
+// Date: December 2025
+// Purpose: Sorted-vector map for the small per-transaction read/write sets
+// Side effects: None - single contiguous buffer, insertion is O(n)
+
+#ifndef FLATMAP_H
+#define FLATMAP_H
+
+#include <algorithm>
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace RepCRec {
+
+// Drop-in subset of std::map for small maps: entries are kept sorted by key,
+// so iteration order matches std::map and lookups are a binary search. The 
+// buffer comes from a caller-supplied memory resource (e.g. a transaction arena).
+template <typename Key, typename Value>
+class FlatMap {
+private:
+    std::pmr::vector<std::pair<Key, Value>> entries;
+
+    static bool keyLess(const std::pair<Key, Value>& entry, const Key& key) {
+        return entry.first < key;
+    }
+
+public:
+    using iterator = typename std::pmr::vector<std::pair<Key, Value>>::iterator;
+    using const_iterator = typename std::pmr::vector<std::pair<Key, Value>>::const_iterator;
+
+    explicit FlatMap(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : entries(resource) {}
+
+    iterator begin() { return entries.begin(); }
+    iterator end() { return entries.end(); }
+    const_iterator begin() const { return entries.begin(); }
+    const_iterator end() const { return entries.end(); }
+
+    bool empty() const { return entries.empty(); }
+    size_t size() const { return entries.size(); }
+    void clear() { entries.clear(); }
+    iterator erase(const_iterator it) { return entries.erase(it); }
+
+    // Resource the entries are allocated from
+    std::pmr::memory_resource* resource() const {
+        return entries.get_allocator().resource();
+    }
+
+    iterator find(const Key& key) {
+        auto it = std::lower_bound(entries.begin(), entries.end(), key, keyLess);
+        return (it != entries.end() && it->first == key) ? it : entries.end();
+    }
+
+    const_iterator find(const Key& key) const {
+        auto it = std::lower_bound(entries.begin(), entries.end(), key, keyLess);
+        return (it != entries.end() && it->first == key) ? it : entries.end();
+    }
+
+    size_t count(const Key& key) const {
+        return find(key) == end() ? 0 : 1;
+    }
+
+    Value& at(const Key& key) {
+        auto it = find(key);
+        if (it == entries.end()) {
+            throw std::out_of_range("FlatMap::at");
+        }
+        return it->second;
+    }
+
+    const Value& at(const Key& key) const {
+        auto it = find(key);
+        if (it == entries.end()) {
+            throw std::out_of_range("FlatMap::at");
+        }
+        return it->second;
+    }
+
+    // Value for key, value-initialized and inserted if absent
+    Value& operator[](const Key& key) {
+        auto it = std::lower_bound(entries.begin(), entries.end(), key, keyLess);
+        if (it == entries.end() || it->first != key) {
+            it = entries.insert(it, std::make_pair(key, Value()));
+        }
+        return it->second;
+    }
+
+    // Inserts only if key is absent, like std::map::emplace
+    std::pair<iterator, bool> emplace(const Key& key, const Value& value) {
+        auto it = std::lower_bound(entries.begin(), entries.end(), key, keyLess);
+        if (it != entries.end() && it->first == key) {
+            return { it, false };
+        }
+        return { entries.insert(it, std::make_pair(key, value)), true };
+    }
+};
+
+}
+
+#endif
@@ -5,138 +5,308 @@
 
 #include "Parser.h"
 #include <iostream>
-#include <sstream>
-#include <algorithm>
+#include <istream>
+#include <ostream>
 #include <cctype>
+#include <charconv>
+#include <cerrno>
+#include <cstdint>
+#include <unistd.h>
 
 namespace RepCRec {
 
 Parser::Parser(std::shared_ptr<TransactionManager> manager) : tm(manager) {}
 
-std::string Parser::trim(const std::string& str) {
-    size_t first = str.find_first_not_of(" \t\n\r");
-    if (first == std::string::npos) 
-        return "";
-    size_t last = str.find_last_not_of(" \t\n\r");
-    return str.substr(first, (last - first + 1));
+namespace {
+
+const std::string_view WHITESPACE = " \t\n\r";
+
+// Bytes of stdin run() reads at a time
+const size_t STDIN_CHUNK_BYTES = 1 << 16;
+
+// Commands take at most this many arguments; extra ones are only counted
+const size_t MAX_ARGUMENTS = 3;
+
+enum class ArgumentRole : uint8_t {
+    TRANSACTION,  // Transaction name
+    VARIABLE,     // "x4" or "4"
+    SITE,         // Site number
+    VALUE         // Written value
+};
+
+// One row of the dispatch table: what a command is called, how many
+// arguments it takes and what each one means
+struct CommandSpec {
+    std::string_view name;
+    CommandOpcode opcode;
+    int arity;  // -1 accepts (and ignores) any number of arguments
+    ArgumentRole roles[MAX_ARGUMENTS];
+};
+
+// Most frequent commands first; lookup is a short scan
+const CommandSpec COMMAND_TABLE[] = {
+    { "R",       CommandOpcode::READ,    2, { ArgumentRole::TRANSACTION, ArgumentRole::VARIABLE } },
+    { "W",       CommandOpcode::WRITE,   3, { ArgumentRole::TRANSACTION, ArgumentRole::VARIABLE,
+                                              ArgumentRole::VALUE } },
+    { "begin",   CommandOpcode::BEGIN,   1, { ArgumentRole::TRANSACTION } },
+    { "end",     CommandOpcode::END,     1, { ArgumentRole::TRANSACTION } },
+    { "fail",    CommandOpcode::FAIL,    1, { ArgumentRole::SITE } },
+    { "recover", CommandOpcode::RECOVER, 1, { ArgumentRole::SITE } },
+    { "dump",    CommandOpcode::DUMP,   -1, {} },
+};
+
+std::string_view trim(std::string_view str) {
+    size_t first = str.find_first_not_of(WHITESPACE);
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    size_t last = str.find_last_not_of(WHITESPACE);
+    return str.substr(first, last - first + 1);
 }
 
-std::vector<std::string> Parser::split(const std::string& str, char delimiter) {
-    std::vector<std::string> tokens;
-    std::stringstream ss(str);
-    std::string token;
-    while (std::getline(ss, token, delimiter)) {
-        tokens.push_back(trim(token));
+const CommandSpec* findCommand(std::string_view name) {
+    for (const CommandSpec& spec : COMMAND_TABLE) {
+        if (spec.name == name) {
+            return &spec;
+        }
     }
-    return tokens;
+    return nullptr;
 }
 
-void Parser::parseCommand(const std::string& line) {
-    std::string trimmedLine = trim(line);
+// Parse a leading integer the way std::stoi does (leading blanks and a sign
+// allowed, trailing characters ignored), without building a string
+bool parseInt(std::string_view str, int& result) {
+    const char* first = str.data();
+    const char* last = str.data() + str.size();
+    while (first != last && std::isspace(static_cast<unsigned char>(*first))) {
+        first++;
+    }
+    if (first != last && *first == '+') {
+        first++;
+    }
+    return std::from_chars(first, last, result).ec == std::errc();
+}
+
+// Extract variable number from "x4" or "4"
+bool parseVariable(std::string_view varStr, int& result) {
+    if (!varStr.empty() && varStr[0] == 'x') {
+        varStr.remove_prefix(1);
+    }
+    return parseInt(varStr, result);
+}
+
+}
+
+bool Parser::parseLine(std::string_view line, ScriptCommand& command, std::string& error) {
+    error.clear();
+    std::string_view trimmedLine = trim(line);
     
     // Skip empty lines and comments
     if (trimmedLine.empty() || trimmedLine[0] == '/' || trimmedLine[0] == '#') {
-        return;
+        return false;
     }
     
     // Find the command name and arguments
     size_t openParen = trimmedLine.find('(');
     size_t closeParen = trimmedLine.find(')');
     
-    if (openParen == std::string::npos) {
-        std::cout << "Error: Invalid command format: " << trimmedLine << std::endl;
-        return;
+    if (openParen == std::string_view::npos) {
+        error = "Invalid command format: " + std::string(trimmedLine);
+        return false;
     }
     
-    std::string command = trim(trimmedLine.substr(0, openParen));
-    std::string argsStr;
+    std::string_view name = trim(trimmedLine.substr(0, openParen));
+    std::string_view argsStr;
     
-    if (closeParen != std::string::npos) {
+    if (closeParen != std::string_view::npos) {
         argsStr = trimmedLine.substr(openParen + 1, closeParen - openParen - 1);
     }
     
-    std::vector<std::string> args = split(argsStr, ',');
-    
-    if (command == "begin") {
-        if (args.size() != 1) {
-            std::cout << "Error: begin requires 1 argument" << std::endl;
-            return;
+    // Split on commas in one pass; like getline, a trailing comma does not
+    // start another (empty) argument
+    std::string_view args[MAX_ARGUMENTS];
+    size_t argCount = 0;
+    size_t start = 0;
+    while (start < argsStr.size()) {
+        size_t comma = argsStr.find(',', start);
+        size_t stop = comma == std::string_view::npos ? argsStr.size() : comma;
+        if (argCount < MAX_ARGUMENTS) {
+            args[argCount] = trim(argsStr.substr(start, stop - start));
+        }
+        argCount++;
+        if (comma == std::string_view::npos) {
+            break;
         }
-        tm->begin(args[0]);
+        start = comma + 1;
     }
-    else if (command == "R") {
-        if (args.size() != 2) {
-            std::cout << "Error: R requires 2 arguments" << std::endl;
-            return;
+    
+    const CommandSpec* spec = findCommand(name);
+    if (!spec) {
+        error = "Unknown command: " + std::string(name);
+        return false;
+    }
+    if (spec->arity >= 0 && argCount != static_cast<size_t>(spec->arity)) {
+        error = std::string(name) + " requires " + std::to_string(spec->arity) +
+                (spec->arity == 1 ? " argument" : " arguments");
+        return false;
+    }
+    
+    command = ScriptCommand();
+    command.opcode = spec->opcode;
+    for (int i = 0; i < spec->arity; i++) {
+        bool valid = true;
+        switch (spec->roles[i]) {
+            case ArgumentRole::TRANSACTION:
+                command.transactionName = args[i];
+                break;
+            case ArgumentRole::VARIABLE:
+                valid = parseVariable(args[i], command.target);
+                break;
+            case ArgumentRole::SITE:
+                valid = parseInt(args[i], command.target);
+                break;
+            case ArgumentRole::VALUE:
+                valid = parseInt(args[i], command.value);
+                break;
         }
-        std::string txnId = args[0];
-        std::string varStr = args[1];
-        
-        // Extract variable number from "x4" or "4"
-        int varId;
-        if (varStr[0] == 'x') {
-            varId = std::stoi(varStr.substr(1));
-        } else {
-            varId = std::stoi(varStr);
+        if (!valid) {
+            error = "Invalid number in " + std::string(name) + ": " + std::string(args[i]);
+            return false;
         }
-        
-        tm->read(txnId, varId);
     }
-    else if (command == "W") {
-        if (args.size() != 3) {
-            std::cout << "Error: W requires 3 arguments" << std::endl;
-            return;
-        }
-        std::string txnId = args[0];
-        std::string varStr = args[1];
-        int value = std::stoi(args[2]);
+    
+    return true;
+}
+
+void Parser::execute(CommandOpcode opcode, const std::string& transactionName, 
+                     int target, int value) {
+    switch (opcode) {
+        case CommandOpcode::BEGIN:
+            tm->begin(transactionName);
+            break;
+        case CommandOpcode::READ:
+            tm->read(transactionName, target);
+            break;
+        case CommandOpcode::WRITE:
+            tm->write(transactionName, target, value);
+            break;
+        case CommandOpcode::END:
+            tm->end(transactionName);
+            break;
+        case CommandOpcode::FAIL:
+            tm->fail(target);
+            break;
+        case CommandOpcode::RECOVER:
+            tm->recover(target);
+            break;
+        case CommandOpcode::DUMP:
+            tm->dump();
+            break;
+        case CommandOpcode::DEFINE_NAME:
+        case CommandOpcode::COMMAND_ERROR:
+            break;
+    }
+}
+
+void Parser::parseCommand(std::string_view line) {
+    ScriptCommand command;
+    std::string error;
+    
+    if (parseLine(line, command, error)) {
+        // Reuses the buffer, so steady-state text input does not allocate
+        transactionName.assign(command.transactionName);
+        execute(command.opcode, transactionName, command.target, command.value);
+    } else if (!error.empty()) {
+        tm->reportCommandError(error);
+    }
+}
+
+void Parser::run() {
+    std::vector<char> chunk(STDIN_CHUNK_BYTES);
+    std::string pending;  // Input read but not yet run, at most one partial line
+    
+    while (true) {
+        // Nothing left to run: report the held commits before a read that may block
+        tm->syncCommitGroup();
         
-        // Extract variable number
-        int varId;
-        if (varStr[0] == 'x') {
-            varId = std::stoi(varStr.substr(1));
-        } else {
-            varId = std::stoi(varStr);
+        ssize_t n = ::read(STDIN_FILENO, chunk.data(), chunk.size());
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
         }
+        pending.append(chunk.data(), static_cast<size_t>(n));
         
-        tm->write(txnId, varId, value);
-    }
-    else if (command == "end") {
-        if (args.size() != 1) {
-            std::cout << "Error: end requires 1 argument" << std::endl;
-            return;
+        std::string_view rest(pending);
+        size_t newline;
+        while ((newline = rest.find('\n')) != std::string_view::npos) {
+            parseCommand(rest.substr(0, newline));
+            rest.remove_prefix(newline + 1);
         }
-        tm->end(args[0]);
+        pending.erase(0, pending.size() - rest.size());
     }
-    else if (command == "fail") {
-        if (args.size() != 1) {
-            std::cout << "Error: fail requires 1 argument" << std::endl;
-            return;
-        }
-        int siteId = std::stoi(args[0]);
-        tm->fail(siteId);
+    
+    if (!pending.empty()) {
+        parseCommand(pending);
     }
-    else if (command == "recover") {
-        if (args.size() != 1) {
-            std::cout << "Error: recover requires 1 argument" << std::endl;
-            return;
+}
+
+void Parser::runText(const char* data, size_t length) {
+    std::string_view rest(data, length);
+    while (!rest.empty()) {
+        size_t newline = rest.find('\n');
+        if (newline == std::string_view::npos) {
+            parseCommand(rest);
+            break;
         }
-        int siteId = std::stoi(args[0]);
-        tm->recover(siteId);
+        parseCommand(rest.substr(0, newline));
+        rest.remove_prefix(newline + 1);
     }
-    else if (command == "dump") {
-        tm->dump();
+}
+
+bool Parser::runBinary(const char* data, size_t length) {
+    static const std::string noTransaction;
+    BinaryScriptReader reader(data, length);
+    CommandView command;
+    
+    while (reader.next(command)) {
+        if (command.opcode == CommandOpcode::COMMAND_ERROR) {
+            tm->reportCommandError(std::string(command.error));
+            continue;
+        }
+        execute(command.opcode, command.transactionName ? *command.transactionName : noTransaction,
+                command.target, command.value);
     }
-    else {
-        std::cout << "Error: Unknown command: " << command << std::endl;
+    
+    if (!reader.getError().empty()) {
+        tm->flushEvents();
+        std::cerr << "Error: " << reader.getError() << std::endl;
+        return false;
     }
+    return true;
 }
 
-void Parser::run() {
+int Parser::convertToBinary(std::istream& in, BinaryScriptWriter& writer, 
+                            std::ostream& diagnostics) {
+    int malformed = 0;
+    int lineNumber = 0;
     std::string line;
-    while (std::getline(std::cin, line)) {
-        parseCommand(line);
+    ScriptCommand command;
+    std::string error;
+    
+    while (std::getline(in, line)) {
+        lineNumber++;
+        if (parseLine(line, command, error)) {
+            writer.append(command);
+        } else if (!error.empty()) {
+            writer.appendError(error);
+            diagnostics << "line " << lineNumber << ": " << error << std::endl;
+            malformed++;
+        }
     }
+    
+    return malformed;
 }
 
-} 
\ No newline at end of file
+}
\ No newline at end of file
@@ -2,7 +2,7 @@
 // Author: Aishwarya and Archita
 // Date: December 2025
 // Purpose: Parse input commands and execute them via TransactionManager
-// Input: String commands from stdin
+// Input: String commands from stdin, or a binary script (CommandProtocol.h)
 // Output: Executes commands
 // Side effects: Calls TransactionManager methods
 
@@ -10,7 +10,10 @@
 #define PARSER_H
 
 #include "TransactionManager.h"
+#include "CommandProtocol.h"
+#include <iosfwd>
 #include <string>
+#include <string_view>
 #include <memory>
 
 namespace RepCRec {
@@ -18,18 +21,93 @@ namespace RepCRec {
 class Parser {
 private:
     std::shared_ptr<TransactionManager> tm;
-    
-    std::string trim(const std::string& str);
-    std::vector<std::string> split(const std::string& str, char delimiter);
+    std::string transactionName;  // Scratch copy of the name being executed
     
 public:
     Parser(std::shared_ptr<TransactionManager> manager);
     
-    void parseCommand(const std::string& line);
+    /**
+     * parseLine - Decode one text command without executing it
+     * Author: Archita Arora
+     * Input:
+     *   - line (string_view): One script line, e.g. "W(T1, x2, 5)"
+     *   - command (ScriptCommand&): Filled on success; its transaction name
+     *                               points into line
+     *   - error (string&): Set when the line is malformed
+     * Output: Boolean - true if line holds a command; false for blank lines, 
+     *         comments (error left empty) and malformed lines (error set)
+     * Description: Single pass over the line with no temporary strings; the
+     *              command name is looked up in a dispatch table that gives
+     *              its arity and the meaning of each argument. Numbers are
+     *              read with from_chars. Only the error path allocates.
+     * Side Effects: None
+     */
+    static bool parseLine(std::string_view line, ScriptCommand& command, std::string& error);
+    
+    // Run one decoded command against the TransactionManager
+    void execute(CommandOpcode opcode, const std::string& transactionName, int target, int value);
+    
+    void parseCommand(std::string_view line);
     
+    /**
+     * run - Execute the script on standard input
+     * Author: Archita Arora
+     * Input: None (reads stdin until end of file)
+     * Output: None
+     * Description: Reads stdin in chunks and runs every complete line of a 
+     *              chunk before reading again. Before each read, which may 
+     *              block on an interactive session, it calls 
+     *              TransactionManager::syncCommitGroup(), so a commit held 
+     *              back for a GROUP fsync is reported by the time the parser 
+     *              waits for more input.
+     * Side Effects:
+     *   - Consumes stdin; reports every command's outcome
+     */
     void run();
+    
+    /**
+     * runText - Execute a text script that is already in memory
+     * Author: Aishwarya Anand
+     * Input:
+     *   - data (const char*): Script text, e.g. a mapped file (MappedScript)
+     *   - length (size_t): Bytes at data
+     * Output: None
+     * Description: Same commands and output as run() on the same script, but
+     *              lines are parsed in place, with no copy into a line buffer.
+     * Side Effects: Calls TransactionManager methods
+     */
+    void runText(const char* data, size_t length);
+    
+    /**
+     * runBinary - Execute a binary script
+     * Author: Aishwarya Anand
+     * Input:
+     *   - data (const char*): Encoded script (see CommandProtocol.h)
+     *   - length (size_t): Bytes at data
+     * Output: Boolean - false if the script was malformed (commands before 
+     *         the bad frame have run); the reason goes to stderr
+     * Description: Decodes frames in place and executes them; output is 
+     *              identical to running the text script it was converted from.
+     * Side Effects: Calls TransactionManager methods
+     */
+    bool runBinary(const char* data, size_t length);
+    
+    /**
+     * convertToBinary - Encode a text script as a binary script
+     * Author: Archita Arora
+     * Input:
+     *   - in (istream&): Text script
+     *   - writer (BinaryScriptWriter&): Receives one frame per command
+     *   - diagnostics (ostream&): Malformed lines are reported here by number
+     * Output: int - Number of malformed lines
+     * Description: A malformed line is encoded as a COMMAND_ERROR frame, so 
+     *              replaying the result reports it where text mode would.
+     * Side Effects: Reads in to the end
+     */
+    static int convertToBinary(std::istream& in, BinaryScriptWriter& writer, 
+                               std::ostream& diagnostics);
 };
 
 } 
 
-#endif 
\ No newline at end of file
+#endif 
@@ -7,7 +7,7 @@
 #ifndef READINFO_H
 #define READINFO_H
 
-#include <string>
+#include "TransactionIdTable.h"
 
 namespace RepCRec {
 
@@ -16,9 +16,9 @@ public:
     int siteId;
     int value;
     int versionTimestamp;
-    std::string writerTransactionId;
+    TxnId writerTransactionId;
     
-    ReadInfo(int site, int val, int versionTime, const std::string& writerId)
+    ReadInfo(int site, int val, int versionTime, TxnId writerId)
         : siteId(site), value(val), versionTimestamp(versionTime), 
           writerTransactionId(writerId) {}
 };
@@ -0,0 +1,97 @@
+// ScriptFile.cpp
+// Author: Aishwarya and Archita
+// Date: December 2025
+// Purpose: Implementation of script mapping and bulk output buffering
+
+#include "ScriptFile.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace RepCRec {
+
+MappedScript::MappedScript(const std::string& path) : base(nullptr), length(0) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open script " + path + ": " + std::strerror(errno));
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        int error = errno;
+        ::close(fd);
+        throw std::runtime_error("Cannot stat script " + path + ": " + std::strerror(error));
+    }
+
+    if (info.st_size > 0) {
+        void* mapping = ::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            int error = errno;
+            ::close(fd);
+            throw std::runtime_error("Cannot map script " + path + ": " + std::strerror(error));
+        }
+        base = static_cast<const char*>(mapping);
+        length = static_cast<size_t>(info.st_size);
+        ::madvise(mapping, length, MADV_SEQUENTIAL);
+    }
+    ::close(fd);
+}
+
+MappedScript::~MappedScript() {
+    if (base) {
+        ::munmap(const_cast<char*>(base), length);
+    }
+}
+
+BulkOutputBuffer::BulkOutputBuffer(std::ostream& target, int outputFd, size_t chunkBytes)
+    : stream(target), previous(nullptr), fd(outputFd), chunk(chunkBytes > 0 ? chunkBytes : 1) {
+    setp(chunk.data(), chunk.data() + chunk.size());
+    target.flush();
+    previous = target.rdbuf(this);
+}
+
+BulkOutputBuffer::~BulkOutputBuffer() {
+    drain();
+    stream.rdbuf(previous);
+}
+
+bool BulkOutputBuffer::drain() {
+    const char* data = pbase();
+    size_t remaining = static_cast<size_t>(pptr() - pbase());
+    while (remaining > 0) {
+        ssize_t n = ::write(fd, data, remaining);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            setp(chunk.data(), chunk.data() + chunk.size());
+            return false;
+        }
+        data += n;
+        remaining -= static_cast<size_t>(n);
+    }
+    setp(chunk.data(), chunk.data() + chunk.size());
+    return true;
+}
+
+BulkOutputBuffer::int_type BulkOutputBuffer::overflow(int_type ch) {
+    if (!drain()) {
+        return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+int BulkOutputBuffer::sync() {
+    // Deliberately deferred until the chunk is full (see the class comment)
+    return 0;
+}
+
+}
@@ -0,0 +1,100 @@
+// ScriptFile.h
+// Author: Aishwarya and Archita
+// Date: December 2025
+// Purpose: Bulk trace replay I/O: a script file mapped into memory for
+//          in-place parsing, and a large-chunk output buffer for std::cout
+// Side effects: MappedScript maps a file; BulkOutputBuffer takes over
+//               std::cout's buffer and writes to stdout
+
+#ifndef SCRIPTFILE_H
+#define SCRIPTFILE_H
+
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace RepCRec {
+
+// Read-only mapping of a whole script file (text or binary)
+class MappedScript {
+private:
+    const char* base;
+    size_t length;
+
+public:
+    /**
+     * MappedScript Constructor
+     * Author: Archita Arora
+     * Input:
+     *   - path (string): Script file to map
+     * Output: None (constructor)
+     * Description: Maps the file with mmap and advises the kernel that it
+     *              will be read sequentially, so a multi-GB trace is paged in
+     *              by readahead instead of being copied through read() calls.
+     *              An empty file gives an empty, unmapped script.
+     * Side Effects:
+     *   - Throws std::runtime_error if the file cannot be opened or mapped
+     */
+    explicit MappedScript(const std::string& path);
+    ~MappedScript();
+
+    MappedScript(const MappedScript&) = delete;
+    MappedScript& operator=(const MappedScript&) = delete;
+
+    const char* data() const { return base; }
+    size_t size() const { return length; }
+};
+
+// Default chunk: few enough write() calls that replay is not syscall-bound
+const size_t BULK_OUTPUT_CHUNK_BYTES = 1 << 20;
+
+/**
+ * BulkOutputBuffer - Replaces the buffer of an ostream while alive
+ * Description: Collects output and writes it to a file descriptor only when
+ *              a chunk fills up and at destruction. Flush requests
+ *              (std::endl, std::flush, the cerr tie) are ignored, so a
+ *              script that prints a line per operation costs one write()
+ *              per chunk rather than one per line. Output still pending when
+ *              the process is killed is lost; this is for bulk replay, not
+ *              interactive use.
+ */
+class BulkOutputBuffer : public std::streambuf {
+private:
+    std::ostream& stream;
+    std::streambuf* previous;
+    int fd;
+    std::vector<char> chunk;
+
+    // Writes out everything buffered so far; false on a write error
+    bool drain();
+
+protected:
+    int_type overflow(int_type ch) override;
+    int sync() override;
+
+public:
+    /**
+     * BulkOutputBuffer Constructor
+     * Author: Aishwarya Anand
+     * Input:
+     *   - target (ostream&): Stream to take over, normally std::cout
+     *   - outputFd (int): Descriptor the chunks are written to
+     *   - chunkBytes (size_t): Buffer size
+     * Output: None (constructor)
+     * Side Effects: Flushes target, then installs this buffer in it
+     */
+    BulkOutputBuffer(std::ostream& target, int outputFd,
+                     size_t chunkBytes = BULK_OUTPUT_CHUNK_BYTES);
+
+    // Writes the remaining output and gives target its old buffer back
+    ~BulkOutputBuffer();
+
+    BulkOutputBuffer(const BulkOutputBuffer&) = delete;
+    BulkOutputBuffer& operator=(const BulkOutputBuffer&) = delete;
+};
+
+}
+
+#endif
@@ -0,0 +1,64 @@
+// SiteSet.h
+// Author: Aishwarya and Archita
+// Date: December 2025
+// Purpose: Fixed-size bitset of site ids (1..MAX_SITES) with set-like iteration
+// Side effects: None - value type, never allocates
+
+#ifndef SITESET_H
+#define SITESET_H
+
+#include <cstdint>
+#include <initializer_list>
+
+namespace RepCRec {
+
+// Upper bound on the configurable site count (bit 0 is unused, sites are 1-based)
+const int MAX_SITES = 63;
+
+class SiteSet {
+private:
+    uint64_t bits;
+
+public:
+    // Forward iterator over the set site ids in ascending order
+    class const_iterator {
+    private:
+        uint64_t remaining;
+
+    public:
+        explicit const_iterator(uint64_t mask) : remaining(mask) {}
+
+        int operator*() const { return __builtin_ctzll(remaining); }
+
+        const_iterator& operator++() {
+            remaining &= remaining - 1;  // clear lowest set bit
+            return *this;
+        }
+
+        bool operator==(const const_iterator& other) const { return remaining == other.remaining; }
+        bool operator!=(const const_iterator& other) const { return remaining != other.remaining; }
+    };
+
+    SiteSet() : bits(0) {}
+
+    SiteSet(std::initializer_list<int> siteIds) : bits(0) {
+        for (int siteId : siteIds) {
+            insert(siteId);
+        }
+    }
+
+    void insert(int siteId) { bits |= uint64_t(1) << siteId; }
+    void erase(int siteId) { bits &= ~(uint64_t(1) << siteId); }
+    void clear() { bits = 0; }
+
+    bool contains(int siteId) const { return (bits >> siteId) & 1; }
+    bool empty() const { return bits == 0; }
+    int size() const { return __builtin_popcountll(bits); }
+
+    const_iterator begin() const { return const_iterator(bits); }
+    const_iterator end() const { return const_iterator(0); }
+};
+
+}
+
+#endif
@@ -0,0 +1,106 @@
+// SiteWorkerPool.cpp
+// Author: Aishwarya and Archita
+// Date: December 2025
+// Purpose: Implementation of the per-site worker threads
+
+#include "SiteWorkerPool.h"
+
+namespace RepCRec {
+
+SiteWorkerPool::SiteWorkerPool(int numSites, ExecutionMode executionMode)
+    : mode(executionMode) {
+    if (mode != ExecutionMode::SITE_THREADS) {
+        return;
+    }
+
+    workers.resize(numSites + 1);
+    for (int siteId = 1; siteId <= numSites; siteId++) {
+        workers[siteId] = std::make_unique<Worker>();
+        Worker& worker = *workers[siteId];
+        worker.thread = std::thread([&worker] { workerLoop(worker); });
+    }
+}
+
+SiteWorkerPool::~SiteWorkerPool() {
+    for (auto& worker : workers) {
+        if (!worker) {
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            worker->stopping = true;
+        }
+        worker->ready.notify_one();
+    }
+    for (auto& worker : workers) {
+        if (worker && worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+void SiteWorkerPool::workerLoop(Worker& worker) {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(worker.mutex);
+            worker.ready.wait(lock, [&worker] { return worker.stopping || !worker.queue.empty(); });
+            if (worker.queue.empty()) {
+                return;
+            }
+            task = std::move(worker.queue.front());
+            worker.queue.pop_front();
+        }
+        task();
+    }
+}
+
+void SiteWorkerPool::post(int siteId, std::function<void()> task) {
+    Worker& worker = *workers[siteId];
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.queue.push_back(std::move(task));
+    }
+    worker.ready.notify_one();
+}
+
+void SiteWorkerPool::runOnSites(const SiteSet& sites, const std::function<void(int)>& task) {
+    if (mode != ExecutionMode::SITE_THREADS) {
+        for (int siteId : sites) {
+            task(siteId);
+        }
+        return;
+    }
+
+    // A lone task still goes through the site's queue: its worker owns the
+    // DataManager while the TM is waiting
+    Batch batch;
+    batch.pending = sites.size();
+
+    for (int siteId : sites) {
+        post(siteId, [&batch, &task, siteId] {
+            std::exception_ptr error;
+            try {
+                task(siteId);
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(batch.mutex);
+            if (error && !batch.error) {
+                batch.error = error;
+            }
+            if (--batch.pending == 0) {
+                batch.done.notify_one();
+            }
+        });
+    }
+
+    std::unique_lock<std::mutex> lock(batch.mutex);
+    batch.done.wait(lock, [&batch] { return batch.pending == 0; });
+    if (batch.error) {
+        std::rethrow_exception(batch.error);
+    }
+}
+
+}
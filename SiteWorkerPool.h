@@ -0,0 +1,106 @@
+// SiteWorkerPool.h
+// Author: Aishwarya and Archita
+// Date: December 2025
+// Purpose: Runs per-site DataManager work either inline (deterministic) or on
+//          one worker thread per site
+// Side effects: Starts and joins worker threads in SITE_THREADS mode
+
+#ifndef SITEWORKERPOOL_H
+#define SITEWORKERPOOL_H
+
+#include "Constants.h"
+#include "SiteSet.h"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RepCRec {
+
+class SiteWorkerPool {
+private:
+    // Tracks one batch of tasks posted to several sites
+    struct Batch {
+        std::mutex mutex;
+        std::condition_variable done;
+        int pending = 0;
+        std::exception_ptr error;
+    };
+
+    // A site's thread and its FIFO message queue
+    struct Worker {
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::deque<std::function<void()>> queue;
+        bool stopping = false;
+    };
+
+    ExecutionMode mode;
+    std::vector<std::unique_ptr<Worker>> workers;  // index siteId; 0 unused
+
+    static void workerLoop(Worker& worker);
+
+    void post(int siteId, std::function<void()> task);
+
+public:
+    /**
+     * SiteWorkerPool Constructor
+     * Author: Archita Arora
+     * Input:
+     *   - numSites (int): Number of sites (1..numSites)
+     *   - executionMode (ExecutionMode): DETERMINISTIC runs tasks inline on
+     *                                    the caller; SITE_THREADS starts one
+     *                                    worker per site
+     * Output: None (constructor)
+     * Side Effects: Starts numSites threads in SITE_THREADS mode
+     */
+    SiteWorkerPool(int numSites, ExecutionMode executionMode);
+
+    /**
+     * SiteWorkerPool Destructor
+     * Author: Aishwarya Anand
+     * Description: Lets every worker drain its queue, then joins it.
+     */
+    ~SiteWorkerPool();
+
+    SiteWorkerPool(const SiteWorkerPool&) = delete;
+    SiteWorkerPool& operator=(const SiteWorkerPool&) = delete;
+
+    /**
+     * runOnSites - Run task(siteId) for every site in sites and wait
+     * Author: Aishwarya Anand
+     * Input:
+     *   - sites (SiteSet): Target sites
+     *   - task (function<void(int)>): Work for one site; it may only touch
+     *                                 that site's DataManager and data owned
+     *                                 by the task
+     * Output: None
+     * Description: In SITE_THREADS mode each site's task is queued on its
+     *              worker and all of them run concurrently; the call returns
+     *              once every one has finished, so the caller may inspect
+     *              DataManagers directly between batches. In DETERMINISTIC
+     *              mode the tasks run inline in ascending site order.
+     * Side Effects:
+     *   - Whatever task does
+     *   - Rethrows the first exception raised by a task, after all finish
+     */
+    void runOnSites(const SiteSet& sites, const std::function<void(int)>& task);
+
+    // runOnSites() for a single site
+    void runOnSite(int siteId, const std::function<void(int)>& task) {
+        runOnSites(SiteSet{siteId}, task);
+    }
+
+    bool isThreaded() const {
+        return mode == ExecutionMode::SITE_THREADS;
+    }
+};
+
+}
+
+#endif
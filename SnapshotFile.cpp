@@ -0,0 +1,123 @@
+// SnapshotFile.cpp
+// Author: Aishwarya and Archita
+// Date: December 2025
+// Purpose: Implementation of checkpoint snapshot files
+
+#include "SnapshotFile.h"
+#include <cerrno>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace RepCRec {
+
+namespace {
+
+const size_t SNAPSHOT_HEADER_BYTES = 2 * sizeof(uint32_t);
+
+void fsyncPath(const std::string& path, int flags) {
+    int fd = ::open(path.c_str(), flags);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path + ": " + std::strerror(errno));
+    }
+    int result = ::fsync(fd);
+    ::close(fd);
+    if (result != 0) {
+        throw std::runtime_error("Cannot sync " + path + ": " + std::strerror(errno));
+    }
+}
+
+}
+
+uint32_t checksumBytes(const char* data, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+SnapshotWriter::SnapshotWriter(uint32_t magic) {
+    put(magic);
+    put(SNAPSHOT_FORMAT_VERSION);
+}
+
+void SnapshotWriter::commit(const std::string& path) {
+    put(checksumBytes(bytes.data(), bytes.size()));
+
+    std::string tempPath = path + ".tmp";
+    int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot create " + tempPath + ": " + std::strerror(errno));
+    }
+
+    const char* data = bytes.data();
+    size_t remaining = bytes.size();
+    while (remaining > 0) {
+        ssize_t n = ::write(fd, data, remaining);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot write " + tempPath + ": " + std::strerror(errno));
+        }
+        data += n;
+        remaining -= static_cast<size_t>(n);
+    }
+
+    if (::fsync(fd) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot sync " + tempPath + ": " + std::strerror(errno));
+    }
+    ::close(fd);
+
+    if (::rename(tempPath.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Cannot rename " + tempPath + ": " + std::strerror(errno));
+    }
+
+    size_t slash = path.find_last_of('/');
+    fsyncPath(slash == std::string::npos ? "." : path.substr(0, slash), O_RDONLY | O_DIRECTORY);
+}
+
+MappedSnapshot::MappedSnapshot(const std::string& path, uint32_t magic)
+    : base(nullptr), length(0), cursor(SNAPSHOT_HEADER_BYTES), present(false), valid(false) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    present = true;
+
+    struct stat info;
+    if (::fstat(fd, &info) == 0 &&
+        static_cast<size_t>(info.st_size) >= SNAPSHOT_HEADER_BYTES + sizeof(uint32_t)) {
+        void* mapping = ::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            base = static_cast<const char*>(mapping);
+            length = static_cast<size_t>(info.st_size);
+        }
+    }
+    ::close(fd);
+
+    if (!base) {
+        return;
+    }
+
+    uint32_t header[2];
+    uint32_t stored;
+    std::memcpy(header, base, sizeof(header));
+    std::memcpy(&stored, base + length - sizeof(uint32_t), sizeof(stored));
+    valid = header[0] == magic && header[1] == SNAPSHOT_FORMAT_VERSION &&
+            stored == checksumBytes(base, length - sizeof(uint32_t));
+}
+
+MappedSnapshot::~MappedSnapshot() {
+    if (base) {
+        ::munmap(const_cast<char*>(base), length);
+    }
+}
+
+}
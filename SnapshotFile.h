@@ -0,0 +1,112 @@
+// SnapshotFile.h
+// Author: Aishwarya and Archita
+// Date: December 2025
+// Purpose: Compact checksummed binary files for checkpoints: atomic write,
+//          mmap-based read
+// Side effects: SnapshotWriter replaces files on disk; MappedSnapshot maps them
+
+#ifndef SNAPSHOTFILE_H
+#define SNAPSHOTFILE_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace RepCRec {
+
+// Bump when the layout of any snapshot file changes
+const uint32_t SNAPSHOT_FORMAT_VERSION = 2;
+
+// FNV-1a over a byte range; shared by snapshot files and the write-ahead log
+uint32_t checksumBytes(const char* data, size_t length);
+
+// Builds a snapshot in memory:
+//   uint32 magic | uint32 format version | fields... | uint32 checksum(all before)
+class SnapshotWriter {
+private:
+    std::vector<char> bytes;
+
+public:
+    explicit SnapshotWriter(uint32_t magic);
+
+    template <typename T>
+    void put(T value) {
+        putArray(&value, 1);
+    }
+
+    template <typename T>
+    void putArray(const T* values, size_t count) {
+        size_t offset = bytes.size();
+        bytes.resize(offset + count * sizeof(T));
+        if (count > 0) {
+            std::memcpy(bytes.data() + offset, values, count * sizeof(T));
+        }
+    }
+
+    /**
+     * commit - Durably replace the file at path with this snapshot
+     * Author: Aishwarya Anand
+     * Input:
+     *   - path (string): Destination file
+     * Output: None
+     * Description: Appends the checksum, writes path + ".tmp", fsyncs it and
+     *              renames it over path, then fsyncs the directory. A crash at
+     *              any point leaves either the old or the new file, never a mix.
+     * Side Effects:
+     *   - Creates/replaces path; throws std::runtime_error on I/O failure
+     */
+    void commit(const std::string& path);
+};
+
+// Read-only view of a snapshot file mapped with mmap. The checksum and header
+// are verified up front; fields are then read sequentially with bounds checks.
+class MappedSnapshot {
+private:
+    const char* base;
+    size_t length;
+    size_t cursor;
+    bool present;
+    bool valid;
+
+public:
+    MappedSnapshot(const std::string& path, uint32_t magic);
+    ~MappedSnapshot();
+
+    MappedSnapshot(const MappedSnapshot&) = delete;
+    MappedSnapshot& operator=(const MappedSnapshot&) = delete;
+
+    // File existed (it may still be invalid)
+    bool exists() const { return present; }
+
+    // Header and checksum matched
+    bool isValid() const { return valid; }
+
+    template <typename T>
+    bool get(T& value) {
+        return getArray(&value, 1);
+    }
+
+    // Unread bytes before the trailing checksum (0 for an invalid file)
+    size_t remaining() const {
+        return valid ? length - sizeof(uint32_t) - cursor : 0;
+    }
+
+    // Copies count values out of the mapping; false if the file is too short
+    template <typename T>
+    bool getArray(T* values, size_t count) {
+        size_t bytesNeeded = count * sizeof(T);
+        if (!valid || bytesNeeded > length - sizeof(uint32_t) - cursor) {
+            return false;
+        }
+        if (count > 0) {
+            std::memcpy(values, base + cursor, bytesNeeded);
+        }
+        cursor += bytesNeeded;
+        return true;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,46 @@
+// TimestampOracle.h
+// Author: Aishwarya and Archita
+// Date: December 2025
+// Purpose: The logical clock all start, commit and event times come from
+// Side effects: None - atomic counter
+
+#ifndef TIMESTAMPORACLE_H
+#define TIMESTAMPORACLE_H
+
+#include <atomic>
+
+namespace RepCRec {
+
+// One counter orders every snapshot and commit. It is atomic so site worker 
+// threads may read the clock while the TM advances it.
+class TimestampOracle {
+private:
+    std::atomic<int> clock;
+    
+public:
+    explicit TimestampOracle(int start = 0) : clock(start) {}
+    
+    TimestampOracle(const TimestampOracle&) = delete;
+    TimestampOracle& operator=(const TimestampOracle&) = delete;
+    
+    // Advance by one and return the new time
+    int tick() { 
+        return clock.fetch_add(1, std::memory_order_acq_rel) + 1; 
+    }
+    
+    int now() const { 
+        return clock.load(std::memory_order_acquire); 
+    }
+    
+    // Move forward to at least time (e.g. after replaying durable state)
+    void advanceTo(int time) {
+        int current = clock.load(std::memory_order_relaxed);
+        while (current < time && 
+               !clock.compare_exchange_weak(current, time, std::memory_order_acq_rel)) {
+        }
+    }
+};
+
+}
+
+#endif
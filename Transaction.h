@@ -11,46 +11,122 @@
 #include "WaitInfo.h"
 #include "ReadInfo.h"
 #include "WriteInfo.h"
+#include "TransactionIdTable.h"
+#include "SiteSet.h"
+#include "FlatMap.h"
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
 #include <string>
-#include <map>
 #include <set>
 
 namespace RepCRec {
 
+// Bytes of per-transaction metadata served from inside the Transaction object 
+// before the arena falls back to the heap
+const size_t TRANSACTION_ARENA_INLINE_BYTES = 1024;
+
+// Serializes access to an unsynchronized memory resource, so site workers can 
+// fill their write buffers from one transaction arena concurrently
+class LockedResource : public std::pmr::memory_resource {
+private:
+    std::pmr::memory_resource* upstream;
+    std::mutex mutex;
+    
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        return upstream->allocate(bytes, alignment);
+    }
+    
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        upstream->deallocate(p, bytes, alignment);
+    }
+    
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+    
+public:
+    explicit LockedResource(std::pmr::memory_resource* resource) : upstream(resource) {}
+};
+
 class Transaction {
+private:
+    // Monotonic arena backing every container below (and this transaction's 
+    // write buffers at each site). Individual frees are no-ops; everything is 
+    // released at once when the Transaction is destroyed. Declared first so 
+    // it outlives the containers that draw from it.
+    std::array<std::byte, TRANSACTION_ARENA_INLINE_BYTES> arenaBuffer;
+    std::pmr::monotonic_buffer_resource arena;
+    LockedResource sharedArena;  // Same arena, for concurrent site workers
+    
+    // The RW edge sets lose nodes whenever the other end retires, so their 
+    // nodes are drawn from a pool over the arena that reuses freed nodes: the 
+    // arena then grows with the peak edge count, not with the edge churn
+    std::pmr::unsynchronized_pool_resource edgePool;
+    
 public:
-    std::string id;
+    TxnId id;
+    std::string name;  // Only used for output
     int startTime;
     int commitTime;
     TransactionStatus status;
     
-    // Read and write tracking
-    std::map<int, ReadInfo> readSet;        
-    std::map<int, WriteInfo> writeSet;      
+    // Read and write tracking (sorted by variableId)
+    FlatMap<int, ReadInfo> readSet;        
+    FlatMap<int, WriteInfo> writeSet;      
     
     // Site access tracking for failure detection
-    std::set<int> writeSites;                    
-    std::map<int, int> firstAccessTimePerSite;   
-    std::set<int> criticalReadSites;             
+    SiteSet writeSites;                    
+    std::array<int, MAX_SITES + 1> firstAccessTimePerSite;  // -1 = not accessed
+    SiteSet criticalReadSites;             
     
     // Conflict tracking for RW-cycle detection
-    std::set<std::string> incomingReadWriteConflicts;  
-    std::set<std::string> outgoingReadWriteConflicts;  
+    std::pmr::set<TxnId> incomingReadWriteConflicts;  
+    std::pmr::set<TxnId> outgoingReadWriteConflicts;  
+    
+    // SSI summary flags; sticky, so they survive retirement of the other end
+    bool hasInConflict;
+    bool hasOutConflict;
+    bool doomed;  // Must abort at end(): a committing pivot depends on it
     
     // Wait information
     WaitInfo waitInfo;
     
-    Transaction(const std::string& txnId, int startT)
-        : id(txnId), startTime(startT), commitTime(-1), status(TransactionStatus::ACTIVE) {}
+    Transaction(TxnId txnId, const std::string& txnName, int startT)
+        : arena(arenaBuffer.data(), arenaBuffer.size()), sharedArena(&arena),
+          edgePool(&arena),
+          id(txnId), name(txnName), startTime(startT), commitTime(-1), status(TransactionStatus::ACTIVE),
+          readSet(&arena), writeSet(&arena), 
+          incomingReadWriteConflicts(&edgePool), outgoingReadWriteConflicts(&edgePool),
+          hasInConflict(false), hasOutConflict(false), doomed(false) {
+        firstAccessTimePerSite.fill(-1);
+    }
+    
+    Transaction(const Transaction&) = delete;
+    Transaction& operator=(const Transaction&) = delete;
+    
+    // Memory resource for metadata owned on this transaction's behalf
+    std::pmr::memory_resource* getArena() {
+        return &arena;
+    }
+    
+    // getArena() guarded by a mutex, for allocations from several threads
+    std::pmr::memory_resource* getSharedArena() {
+        return &sharedArena;
+    }
     
     // Check if this transaction is waiting
     bool isWaiting() const {
         return status == TransactionStatus::WAITING;
     }
     
-    // Add a read operation
-    void addRead(int variableId, int siteId, int value, int versionTime, const std::string& writerId) {
-        readSet.emplace(variableId, ReadInfo(siteId, value, versionTime, writerId));
+    // Add a read operation; returns true on the first read of variableId so the
+    // caller can register this transaction in its per-variable reader index
+    bool addRead(int variableId, int siteId, int value, int versionTime, TxnId writerId) {
+        return readSet.emplace(variableId, ReadInfo(siteId, value, versionTime, writerId)).second;
     }
     
     // Add a write operation
@@ -62,17 +138,31 @@ public:
         }
     }
     
+    // Record the first time this transaction touched a site
+    void recordSiteAccess(int siteId, int time) {
+        if (firstAccessTimePerSite[siteId] == -1) {
+            firstAccessTimePerSite[siteId] = time;
+        }
+    }
+    
+    // First access time for a site, or -1 if never accessed
+    int getFirstAccessTime(int siteId) const {
+        return firstAccessTimePerSite[siteId];
+    }
+    
     // Add RW conflict edges
-    void addIncomingRWEdge(const std::string& fromTxnId) {
+    void addIncomingRWEdge(TxnId fromTxnId) {
         incomingReadWriteConflicts.insert(fromTxnId);
+        hasInConflict = true;
     }
     
-    void addOutgoingRWEdge(const std::string& toTxnId) {
+    void addOutgoingRWEdge(TxnId toTxnId) {
         outgoingReadWriteConflicts.insert(toTxnId);
+        hasOutConflict = true;
     }
     
     // Mark transaction as waiting
-    void setWaiting(int variableId, const std::set<int>& candidateSites) {
+    void setWaiting(int variableId, const SiteSet& candidateSites) {
         status = TransactionStatus::WAITING;
         waitInfo = WaitInfo(variableId, candidateSites);
     }
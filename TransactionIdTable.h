@@ -0,0 +1,68 @@
+// TransactionIdTable.h
+// Author: Aishwarya and Archita
+// Date: December 2025
+// Purpose: Intern transaction names ("T1", "T2", ...) as dense integer ids
+// Side effects: Grows the table the first time a name is interned
+
+#ifndef TRANSACTIONIDTABLE_H
+#define TRANSACTIONIDTABLE_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace RepCRec {
+
+// Compact transaction identity used by every internal structure
+using TxnId = int;
+
+// Reserved id for the writer of the initial versions (xi = 10i)
+const TxnId INITIAL_TXN_ID = 0;
+const TxnId INVALID_TXN_ID = -1;
+
+// Writer of a version rebuilt from a log or checkpoint. Ids are interned per 
+// process, so durable state identifies a version by its commit time only.
+const TxnId RECOVERED_TXN_ID = -2;
+
+class TransactionIdTable {
+private:
+    std::unordered_map<std::string, TxnId> idsByName;
+    std::vector<std::string> namesById;
+
+public:
+    TransactionIdTable() {
+        intern("INITIAL");
+    }
+
+    // Return the id for a name, assigning the next dense id if it is new.
+    // A name that is reused (e.g. T1 in consecutive scripts) keeps its id.
+    TxnId intern(const std::string& name) {
+        auto it = idsByName.find(name);
+        if (it != idsByName.end()) {
+            return it->second;
+        }
+        TxnId id = static_cast<TxnId>(namesById.size());
+        idsByName.emplace(name, id);
+        namesById.push_back(name);
+        return id;
+    }
+
+    // Look up a name without interning it
+    TxnId find(const std::string& name) const {
+        auto it = idsByName.find(name);
+        return it == idsByName.end() ? INVALID_TXN_ID : it->second;
+    }
+
+    // Name for output; only valid for ids returned by intern()
+    const std::string& name(TxnId id) const {
+        return namesById[id];
+    }
+
+    int size() const {
+        return static_cast<int>(namesById.size());
+    }
+};
+
+}
+
+#endif
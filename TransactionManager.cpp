@@ -5,53 +5,119 @@
 
 
 #include "TransactionManager.h"
+#include "SnapshotFile.h"
 #include <iostream>
 #include <algorithm>
 #include <queue>
+#include <stdexcept>
 
 namespace RepCRec {
 
-TransactionManager::TransactionManager() : currentTimestamp(0) {
-    for (int i = 1; i <= NUM_SITES; i++) {
-        dataManagers[i] = std::make_shared<DataManager>(i);
+namespace {
+
+// "RCSS": site failure history
+const uint32_t SITE_STATES_MAGIC = 0x53534352;
+
+}
+
+TransactionManager::TransactionManager(ValidationMode mode, const WalConfig& wal,
+                                       RecoveryMode recovery, ReplicaSelection selection,
+                                       ExecutionMode execution) 
+    : currentTimestamp(0), validationMode(mode), recoveryMode(recovery), 
+      replicaSelection(selection), nextReplicaSite(1), 
+      readsServedBySite(getNumSites() + 1, 0), outstandingReadsBySite(getNumSites() + 1, 0),
+      lastGcWaterMark(-1),
+      sitePool(getNumSites(), execution), walConfig(wal), commitsSinceCheckpoint(0), 
+      events(std::make_unique<TextEventSink>(std::cout)), unsyncedGroupCommits(0) {
+    for (int i = 1; i <= getNumSites(); i++) {
+        dataManagers[i] = std::make_shared<DataManager>(i, walConfig);
         siteStates[i] = SiteState(i);
+        allSiteIds.insert(i);
+        currentTimestamp.advanceTo(dataManagers[i]->getLastLoggedTimestamp());
+    }
+    
+    if (walConfig.durability != DurabilityLevel::OFF) {
+        loadSiteStates();
     }
 }
 
 void TransactionManager::begin(const std::string& transactionId) {
-    currentTimestamp++;
-    auto txn = std::make_shared<Transaction>(transactionId, currentTimestamp);
-    transactions[transactionId] = txn;
-    std::cout << "Transaction " << transactionId << " begins at time " 
-              << currentTimestamp << std::endl;
+    int startTime = currentTimestamp.tick();
+    TxnId id = transactionIds.intern(transactionId);
+    auto txn = std::make_shared<Transaction>(id, transactionId, startTime);
+    transactions[id] = txn;
+    
+    if (id >= static_cast<TxnId>(liveById.size())) {
+        liveById.resize(id + 1);
+        committedById.resize(id + 1);
+    }
+    
+    // A superseded live incarnation may be released with this slot, and its 
+    // site write buffers live in its arena. Every index that names it by id 
+    // is cleared too, or the new incarnation would inherit its reads and RW 
+    // edges.
+    if (const auto& superseded = liveById[id]) {
+        sitePool.runOnSites(superseded->writeSites, [&](int siteId) {
+            dataManagers.at(siteId)->abortWrites(id);
+        });
+        removeFromReaderIndex(superseded);
+        releaseOutstandingReads(superseded);
+        
+        for (TxnId toTxnId : superseded->outgoingReadWriteConflicts) {
+            if (Transaction* to = findTransaction(toTxnId)) {
+                to->incomingReadWriteConflicts.erase(id);
+            }
+        }
+        for (TxnId fromTxnId : superseded->incomingReadWriteConflicts) {
+            if (Transaction* from = findTransaction(fromTxnId)) {
+                from->outgoingReadWriteConflicts.erase(id);
+            }
+        }
+    }
+    liveById[id] = txn;
+    
+    Event event(EventType::BEGIN, startTime);
+    event.transaction = transactionId;
+    emit(std::move(event));
 }
 
 // READ OPERATIONS
 
 void TransactionManager::read(const std::string& transactionId, int variableId) {
-    currentTimestamp++;
+    currentTimestamp.tick();
     
-    auto it = transactions.find(transactionId);
+    auto it = transactions.find(transactionIds.find(transactionId));
     if (it == transactions.end()) {
-        std::cout << "Error: Transaction " << transactionId << " not found" << std::endl;
+        Event event(EventType::TRANSACTION_NOT_FOUND, currentTimestamp.now());
+        event.transaction = transactionId;
+        emit(std::move(event));
         return;
     }
     
     auto txn = it->second;
     
+    if (!checkVariable(variableId)) {
+        return;
+    }
+    
     if (txn->isWaiting()) {
-        std::cout << "Transaction " << transactionId << " is waiting" << std::endl;
+        Event event(EventType::STILL_WAITING, currentTimestamp.now());
+        event.transaction = transactionId;
+        emit(std::move(event));
         return;
     }
     
     // Read-your-own-write
     if (txn->writeSet.find(variableId) != txn->writeSet.end()) {
-        int value = txn->writeSet.at(variableId).value;
-        std::cout << "x" << variableId << ": " << value << " (RYOW)" << std::endl;
+        Event event(EventType::READ_OWN_WRITE, currentTimestamp.now());
+        event.transaction = transactionId;
+        event.variable = variableId;
+        event.value = txn->writeSet.at(variableId).value;
+        emit(std::move(event));
         return;
     }
     
-    if (isOddVariable(variableId)) {
+    if (!isReplicatedVariable(variableId)) {
         readFromHomeSite(txn, variableId);
     } else {
         readReplicated(txn, variableId);
@@ -62,38 +128,46 @@ void TransactionManager::readFromHomeSite(std::shared_ptr<Transaction> txn, int
     int homeSite = getHomeSite(variableId);
     
     if (!siteStates[homeSite].isUp) {
-        std::cout << "Transaction " << txn->id << " waits (site " << homeSite 
-                  << " down)" << std::endl;
-        std::set<int> candidateSites = {homeSite};
+        Event event(EventType::WAIT_SITE_DOWN, currentTimestamp.now());
+        event.transaction = txn->name;
+        event.variable = variableId;
+        event.site = homeSite;
+        emit(std::move(event));
+        SiteSet candidateSites = {homeSite};
         txn->setWaiting(variableId, candidateSites);
         return;
     }
     
-    auto version = dataManagers[homeSite]->readVariable(variableId, txn->startTime);
+    // Lock-free snapshot read; no need to queue behind the site's worker
+    VersionView version = dataManagers.at(homeSite)->readVariable(variableId, txn->startTime);
     
     if (!version) {
-        std::cout << "Error: No version for x" << variableId << std::endl;
+        Event event(EventType::NO_VERSION, currentTimestamp.now());
+        event.variable = variableId;
+        emit(std::move(event));
         return;
     }
     
-    txn->addRead(variableId, homeSite, version->value, 
-                 version->commitTimestamp, version->writerTransactionId);
+    bool firstRead = txn->addRead(variableId, homeSite, version.value(), 
+                                  version.commitTimestamp(), version.writerTransactionId());
+    if (firstRead) {
+        readersByVariable[variableId].push_back(txn);
+    }
+    recordSiteRead(homeSite, firstRead);
     txn->criticalReadSites.insert(homeSite);
 
-    if (txn->firstAccessTimePerSite.find(homeSite) == txn->firstAccessTimePerSite.end()) {
-        txn->firstAccessTimePerSite[homeSite] = currentTimestamp;
-    }
+    txn->recordSiteAccess(homeSite, currentTimestamp.now());
     
-    std::cout << "x" << variableId << ": " << version->value << std::endl;
+    emitRead(*txn, variableId, version.value(), homeSite);
 }
 
 void TransactionManager::readReplicated(std::shared_ptr<Transaction> txn, int variableId) {
-    std::set<int> validSites = computeValidSnapshotSites(txn, variableId);
+    SiteSet validSites = computeValidSnapshotSites(txn, variableId);
     
     if (validSites.empty()) {
 
-        std::set<int> allSites = getVariableSites(variableId);
-        std::set<int> potentialSites; 
+        const SiteSet& allSites = getVariableSites(variableId);
+        SiteSet potentialSites; 
         
         for (int siteId : allSites) {
             if (!siteStates[siteId].isUp) {
@@ -114,7 +188,10 @@ void TransactionManager::readReplicated(std::shared_ptr<Transaction> txn, int va
         }
         
         if (!potentialSites.empty()) {
-            std::cout << "Transaction " << txn->id << " waits (no valid site)" << std::endl;
+            Event event(EventType::WAIT_NO_VALID_SITE, currentTimestamp.now());
+            event.transaction = txn->name;
+            event.variable = variableId;
+            emit(std::move(event));
             txn->setWaiting(variableId, potentialSites);
         } else {
             abort(txn, "No valid snapshot for x" + std::to_string(variableId));
@@ -122,103 +199,171 @@ void TransactionManager::readReplicated(std::shared_ptr<Transaction> txn, int va
         return;
     }
     
-    int chosenSite = *validSites.begin();
+    int chosenSite = chooseReplica(txn, validSites);
     
-    auto& versions = dataManagers[chosenSite]->getDataStore()[variableId];
-    std::shared_ptr<Version> version = nullptr;
-    for (auto it = versions.rbegin(); it != versions.rend(); ++it) {
-        if (it->commitTimestamp <= txn->startTime) {
-            version = std::make_shared<Version>(*it);
-            break;
-        }
-    }
+    VersionView version = dataManagers.at(chosenSite)->findVersionAt(variableId, 
+                                                                     txn->startTime);
     
     if (!version) {
-        std::cout << "Error: No version for x" << variableId << std::endl;
+        Event event(EventType::NO_VERSION, currentTimestamp.now());
+        event.variable = variableId;
+        emit(std::move(event));
         return;
     }
     
-    txn->addRead(variableId, chosenSite, version->value, version->commitTimestamp, version->writerTransactionId);
+    bool firstRead = txn->addRead(variableId, chosenSite, version.value(), 
+                                  version.commitTimestamp(), version.writerTransactionId());
+    if (firstRead) {
+        readersByVariable[variableId].push_back(txn);
+    }
+    recordSiteRead(chosenSite, firstRead);
     
     // Track first access time for this site
-    if (txn->firstAccessTimePerSite.find(chosenSite) == txn->firstAccessTimePerSite.end()) {
-        txn->firstAccessTimePerSite[chosenSite] = currentTimestamp;
-    }
+    txn->recordSiteAccess(chosenSite, currentTimestamp.now());
     
-    std::cout << "x" << variableId << ": " << version->value << std::endl;
+    emitRead(*txn, variableId, version.value(), chosenSite);
 }
 
 // WRITE OPERATIONS
 
 void TransactionManager::write(const std::string& transactionId, int variableId, int value) {
-    currentTimestamp++;
+    currentTimestamp.tick();
     
-    auto it = transactions.find(transactionId);
+    auto it = transactions.find(transactionIds.find(transactionId));
     if (it == transactions.end()) {
-        std::cout << "Error: Transaction " << transactionId << " not found" << std::endl;
+        Event event(EventType::TRANSACTION_NOT_FOUND, currentTimestamp.now());
+        event.transaction = transactionId;
+        emit(std::move(event));
         return;
     }
     
     auto txn = it->second;
+    
+    if (!checkVariable(variableId)) {
+        return;
+    }
+    
     txn->addWrite(variableId, value);
     
-    std::set<int> sites = getVariableSites(variableId);
-    std::vector<int> sitesWritten;
+    const SiteSet& sites = getVariableSites(variableId);
+    SiteSet targetSites;
     
     for (int site : sites) {
         if (siteStates[site].isUp) {
-            dataManagers[site]->writeVariable(variableId, value, transactionId);
+            targetSites.insert(site);
             txn->writeSites.insert(site);
             txn->writeSet.at(variableId).addSite(site);
             
-            if (txn->firstAccessTimePerSite.find(site) == txn->firstAccessTimePerSite.end()) {
-                txn->firstAccessTimePerSite[site] = currentTimestamp;
-            }
-            
-            sitesWritten.push_back(site);
+            txn->recordSiteAccess(site, currentTimestamp.now());
         }
     }
     
-    std::cout << "W(" << transactionId << ", x" << variableId << ", " << value << ") -> sites:";
-    for (int s : sitesWritten) 
-        std::cout << " " << s;
-    std::cout << std::endl;
+    std::pmr::memory_resource* arena = sitePool.isThreaded() ? txn->getSharedArena() 
+                                                             : txn->getArena();
+    sitePool.runOnSites(targetSites, [&](int siteId) {
+        dataManagers.at(siteId)->writeVariable(variableId, value, txn->id, arena);
+    });
+    
+    Event event(EventType::WRITE, currentTimestamp.now());
+    event.transaction = transactionId;
+    event.variable = variableId;
+    event.value = value;
+    event.sites = targetSites;
+    emit(std::move(event));
+}
+
+int TransactionManager::chooseReplica(const std::shared_ptr<Transaction>& txn, 
+                                      const SiteSet& validSites) {
+    int numSites = getNumSites();
+    
+    // First valid site at or after start, wrapping around
+    auto firstValidFrom = [&](int start) {
+        for (int offset = 0; offset < numSites; offset++) {
+            int siteId = 1 + (start - 1 + offset) % numSites;
+            if (validSites.contains(siteId)) {
+                return siteId;
+            }
+        }
+        return *validSites.begin();
+    };
+    
+    switch (replicaSelection) {
+        case ReplicaSelection::ROUND_ROBIN: {
+            int siteId = firstValidFrom(nextReplicaSite);
+            nextReplicaSite = 1 + siteId % numSites;
+            return siteId;
+        }
+        
+        case ReplicaSelection::LEAST_OUTSTANDING: {
+            int best = *validSites.begin();
+            for (int siteId : validSites) {
+                if (outstandingReadsBySite[siteId] < outstandingReadsBySite[best] ||
+                    (outstandingReadsBySite[siteId] == outstandingReadsBySite[best] &&
+                     readsServedBySite[siteId] < readsServedBySite[best])) {
+                    best = siteId;
+                }
+            }
+            return best;
+        }
+        
+        case ReplicaSelection::AFFINITY: {
+            for (int siteId : validSites) {
+                if (txn->getFirstAccessTime(siteId) != -1) {
+                    return siteId;
+                }
+            }
+            return firstValidFrom(1 + txn->id % numSites);
+        }
+        
+        case ReplicaSelection::LOWEST_SITE:
+        default:
+            return *validSites.begin();
+    }
+}
+
+void TransactionManager::recordSiteRead(int siteId, bool firstReadOfVariable) {
+    readsServedBySite[siteId]++;
+    if (firstReadOfVariable) {
+        outstandingReadsBySite[siteId]++;
+    }
+}
+
+void TransactionManager::releaseOutstandingReads(const std::shared_ptr<Transaction>& txn) {
+    for (const auto& [variableId, readInfo] : txn->readSet) {
+        outstandingReadsBySite[readInfo.siteId]--;
+    }
 }
 
 // VALIDATION METHODS
 
-std::set<int> TransactionManager::computeValidSnapshotSites(
+SiteSet TransactionManager::computeValidSnapshotSites(
     std::shared_ptr<Transaction> txn, int variableId) {
     
-    std::set<int> validSites;
-    std::set<int> allSites = getVariableSites(variableId);
+    SiteSet validSites;
+    const SiteSet& allSites = getVariableSites(variableId);
     
     for (int siteId : allSites) {
         if (!siteStates[siteId].isUp) continue;
         
-        if (isOddVariable(variableId)) {
+        if (!isReplicatedVariable(variableId)) {
             validSites.insert(siteId);
             continue;
         }
         
         // For replicated variables, we need to check if this site can serve
         // a valid snapshot for this transaction.
-        auto& versions = dataManagers[siteId]->getDataStore()[variableId];
-        std::shared_ptr<Version> version = nullptr;
-        for (auto it = versions.rbegin(); it != versions.rend(); ++it) {
-            if (it->commitTimestamp <= txn->startTime) {
-                version = std::make_shared<Version>(*it);
-                break;
-            }
-        }
+        VersionView version = dataManagers[siteId]->findVersionAt(variableId, txn->startTime);
         
         if (!version) 
             continue;
         
-        int commitTime = version->commitTimestamp;
+        int commitTime = version.commitTimestamp();
         
         // Check if site was up continuously from the commit to txn's start time
-        if (wasSiteUpContinuously(siteId, commitTime, txn->startTime)) {
+        // (a caught-up site has every version, so its failures do not matter)
+        if ((recoveryMode == RecoveryMode::CATCH_UP && 
+             dataManagers[siteId]->hasCompleteHistory(variableId)) ||
+            wasSiteUpContinuously(siteId, commitTime, txn->startTime)) {
             validSites.insert(siteId);
         }
     }
@@ -233,12 +378,12 @@ bool TransactionManager::wasSiteUpContinuously(int siteId, int fromTime, int toT
 bool TransactionManager::violatesFailureRule(std::shared_ptr<Transaction> txn) {
     // Check write sites
     for (int siteId : txn->writeSites) {
-        int firstAccess = txn->firstAccessTimePerSite[siteId];
+        int firstAccess = txn->getFirstAccessTime(siteId);
         const auto& failureHistory = siteStates[siteId].failureHistory;
         
         for (const auto& interval : failureHistory) {
             if (interval.failTime >= firstAccess && 
-                interval.failTime < currentTimestamp) {
+                interval.failTime < txn->commitTime) {
                 return true;
             }
         }
@@ -248,16 +393,15 @@ bool TransactionManager::violatesFailureRule(std::shared_ptr<Transaction> txn) {
     // But we implemented an additional safety check for odd-indexed variable reads
     // if a transaction reads an odd-indexed  variable from a site that subsequently fails, the transaction will abort
     for (int siteId : txn->criticalReadSites) {
-        auto accessIt = txn->firstAccessTimePerSite.find(siteId);
-        if (accessIt == txn->firstAccessTimePerSite.end()) {
+        int firstAccess = txn->getFirstAccessTime(siteId);
+        if (firstAccess == -1) {
             continue; 
         }
-        int firstAccess = accessIt->second;
         
         const auto& failureHistory = siteStates[siteId].failureHistory;
         for (const auto& interval : failureHistory) {
             if (interval.failTime >= firstAccess && 
-                interval.failTime < currentTimestamp) {
+                interval.failTime < txn->commitTime) {
                 return true;
             }
         }
@@ -268,12 +412,13 @@ bool TransactionManager::violatesFailureRule(std::shared_ptr<Transaction> txn) {
 
 bool TransactionManager::violatesFirstCommitterWins(std::shared_ptr<Transaction> txn) {
     for (const auto& [variableId, writeInfo] : txn->writeSet) {
-        if (variableCommitHistory.find(variableId) == variableCommitHistory.end()) {
+        auto historyIt = variableCommitHistory.find(variableId);
+        if (historyIt == variableCommitHistory.end()) {
             continue;
         }
         
-        for (const auto& [committedTxnId, commitTime] : variableCommitHistory[variableId]) {
-            if (commitTime > txn->startTime && commitTime < currentTimestamp) {
+        for (const auto& [committedTxnId, commitTime] : historyIt->second) {
+            if (commitTime > txn->startTime && commitTime < txn->commitTime) {
                 return true;
             }
         }
@@ -287,17 +432,22 @@ bool TransactionManager::violatesReadWriteCycle(std::shared_ptr<Transaction> txn
 
     createRWEdgesForCommit(txn);
     
-    std::set<std::string> visited;
+    if (validationMode == ValidationMode::PIVOT_FLAGS) {
+        return isDangerousPivot(txn);
+    }
+    
+    std::set<TxnId> visited;
     if (hasRWCyclePath(txn->id, txn->id, 0, visited)) {
         return true;
     }
     
     for (const auto& [variableId, writeInfo] : txn->writeSet) {
-        if (variableCommitHistory.find(variableId) == variableCommitHistory.end()) {
+        auto historyIt = variableCommitHistory.find(variableId);
+        if (historyIt == variableCommitHistory.end()) {
             continue;
         }
         
-        for (const auto& [committedTxnId, commitTime] : variableCommitHistory[variableId]) {
+        for (const auto& [committedTxnId, commitTime] : historyIt->second) {
             if (hasPathViaRW(txn->id, committedTxnId)) {
                 return true;
             }
@@ -311,45 +461,79 @@ bool TransactionManager::violatesReadWriteCycle(std::shared_ptr<Transaction> txn
     return false;
 }
 
+bool TransactionManager::isDangerousPivot(std::shared_ptr<Transaction> txn) {
+    if (txn->doomed) {
+        return true;
+    }
+    
+    if (!txn->hasInConflict || !txn->hasOutConflict) {
+        return false;
+    }
+    
+    // In-edges to txn are created only by its own commit, so each T_in is 
+    // either live or committed; an empty set means they have all retired
+    if (txn->incomingReadWriteConflicts.empty()) {
+        return true;
+    }
+    
+    std::vector<Transaction*> nearConflicts;
+    for (TxnId inTxnId : txn->incomingReadWriteConflicts) {
+        Transaction* inTxn = findTransaction(inTxnId);
+        if (!inTxn || inTxn->status == TransactionStatus::COMMITTED) {
+            return true;
+        }
+        nearConflicts.push_back(inTxn);
+    }
+    
+    for (Transaction* inTxn : nearConflicts) {
+        inTxn->doomed = true;
+    }
+    return false;
+}
+
 void TransactionManager::createRWEdgesForCommit(std::shared_ptr<Transaction> committingTxn) {
+    int commitTime = committingTxn->commitTime;
     for (const auto& [variableId, writeInfo] : committingTxn->writeSet) {
-        
-        // Check active transactions
-        for (auto& [txnId, txn] : transactions) {
-            if (txnId == committingTxn->id) 
-                continue;
-            if (txn->startTime >= currentTimestamp) 
-                continue;  
-            
-            auto readIt = txn->readSet.find(variableId);
-            if (readIt != txn->readSet.end()) {
-                txn->addOutgoingRWEdge(committingTxn->id);
-                committingTxn->addIncomingRWEdge(txn->id);
-            }
+        auto readersIt = readersByVariable.find(variableId);
+        if (readersIt == readersByVariable.end()) {
+            continue;
         }
         
-        // Check already committed transactions
-        for (auto& txn : committedTransactions) {
+        for (const auto& txn : readersIt->second) {
             if (txn->id == committingTxn->id) 
                 continue;
-
-            if (txn->startTime >= currentTimestamp) 
+            if (txn->startTime >= commitTime) 
                 continue;
             
-            auto readIt = txn->readSet.find(variableId);
-            if (readIt != txn->readSet.end()) {
-
-                if (readIt->second.versionTimestamp < currentTimestamp) {
-                    // RW edge from reader to writer
-                    txn->addOutgoingRWEdge(committingTxn->id);
-                    committingTxn->addIncomingRWEdge(txn->id);
-                }
+            if (txn->status == TransactionStatus::COMMITTED) {
+                // Already committed reader
+                if (txn->readSet.at(variableId).versionTimestamp >= commitTime) 
+                    continue;
             }
+            
+            // RW edge from reader to writer
+            txn->addOutgoingRWEdge(committingTxn->id);
+            committingTxn->addIncomingRWEdge(txn->id);
+        }
+    }
+}
+
+void TransactionManager::removeFromReaderIndex(const std::shared_ptr<Transaction>& txn) {
+    for (const auto& [variableId, readInfo] : txn->readSet) {
+        auto readersIt = readersByVariable.find(variableId);
+        if (readersIt == readersByVariable.end()) {
+            continue;
+        }
+        
+        auto& readers = readersIt->second;
+        readers.erase(std::remove(readers.begin(), readers.end(), txn), readers.end());
+        if (readers.empty()) {
+            readersByVariable.erase(readersIt);
         }
     }
 }
 
-bool TransactionManager::hasRWCyclePath(const std::string& fromTxnId, const std::string& targetTxnId, int edgeCount, std::set<std::string>& visited) {
+bool TransactionManager::hasRWCyclePath(TxnId fromTxnId, TxnId targetTxnId, int edgeCount, std::set<TxnId>& visited) {
     
     if (fromTxnId == targetTxnId && edgeCount >= 2) 
         return true;
@@ -357,23 +541,12 @@ bool TransactionManager::hasRWCyclePath(const std::string& fromTxnId, const std:
         return false;
     visited.insert(fromTxnId);
     
-    auto it = transactions.find(fromTxnId);
-    if (it == transactions.end()) {
-        for (const auto& committedTxn : committedTransactions) {
-            if (committedTxn->id == fromTxnId) {
-                for (const std::string& nextTxnId : committedTxn->outgoingReadWriteConflicts) {
-                    if (hasRWCyclePath(nextTxnId, targetTxnId, edgeCount + 1, visited)) {
-                        return true;
-                    }
-                }
-                return false;
-            }
-        }
+    Transaction* txn = findTransaction(fromTxnId);
+    if (!txn) {
         return false;
     }
     
-    auto txn = it->second;
-    for (const std::string& nextTxnId : txn->outgoingReadWriteConflicts) {
+    for (TxnId nextTxnId : txn->outgoingReadWriteConflicts) {
         if (hasRWCyclePath(nextTxnId, targetTxnId, edgeCount + 1, visited)) {
             return true;
         }
@@ -382,39 +555,28 @@ bool TransactionManager::hasRWCyclePath(const std::string& fromTxnId, const std:
     return false;
 }
 
-bool TransactionManager::hasPathViaRW(const std::string& fromTxnId, const std::string& toTxnId) {
-    std::queue<std::string> q;
-    std::set<std::string> visited;
+bool TransactionManager::hasPathViaRW(TxnId fromTxnId, TxnId toTxnId) {
+    std::queue<TxnId> q;
+    std::set<TxnId> visited;
     
     q.push(fromTxnId);
     visited.insert(fromTxnId);
     
     while (!q.empty()) {
-        std::string current = q.front();
+        TxnId current = q.front();
         q.pop();
         
         if (current == toTxnId) 
             return true;
         
-        auto it = transactions.find(current);
-        if (it == transactions.end()) {
-            for (const auto& committedTxn : committedTransactions) {
-                if (committedTxn->id == current) {
-                    for (const std::string& next : committedTxn->outgoingReadWriteConflicts) {
-                        if (visited.find(next) == visited.end()) {
-                            visited.insert(next);
-                            q.push(next);
-                        }
-                    }
-                    break;
-                }
-            }
-        } else {
-            for (const std::string& next : it->second->outgoingReadWriteConflicts) {
-                if (visited.find(next) == visited.end()) {
-                    visited.insert(next);
-                    q.push(next);
-                }
+        Transaction* txn = findTransaction(current);
+        if (!txn) 
+            continue;
+        
+        for (TxnId next : txn->outgoingReadWriteConflicts) {
+            if (visited.find(next) == visited.end()) {
+                visited.insert(next);
+                q.push(next);
             }
         }
     }
@@ -422,32 +584,49 @@ bool TransactionManager::hasPathViaRW(const std::string& fromTxnId, const std::s
     return false;
 }
 
+Transaction* TransactionManager::findTransaction(TxnId txnId) const {
+    if (txnId < 0 || txnId >= static_cast<TxnId>(liveById.size())) {
+        return nullptr;
+    }
+    if (liveById[txnId]) {
+        return liveById[txnId].get();
+    }
+    return committedById[txnId].get();
+}
+
 
 // COMMIT/ABORT
 
 void TransactionManager::end(const std::string& transactionId) {
-    currentTimestamp++;
+    int endTime = currentTimestamp.tick();
     
-    auto it = transactions.find(transactionId);
+    auto it = transactions.find(transactionIds.find(transactionId));
     if (it == transactions.end()) {
-        std::cout << "Error: Transaction " << transactionId << " not found" << std::endl;
+        Event event(EventType::TRANSACTION_NOT_FOUND, currentTimestamp.now());
+        event.transaction = transactionId;
+        emit(std::move(event));
         return;
     }
     
     auto txn = it->second;
+    txn->commitTime = endTime;
     
+    const char* abortReason = nullptr;
     if (violatesFailureRule(txn)) {
-        abort(txn, "Site failure");
-        return;
-    }
-    
-    if (violatesFirstCommitterWins(txn)) {
-        abort(txn, "First-committer-wins");
-        return;
+        abortReason = "Site failure";
+    } else if (violatesFirstCommitterWins(txn)) {
+        abortReason = "First-committer-wins";
+    } else if (violatesReadWriteCycle(txn)) {
+        abortReason = "RW-cycle";
+    } else {
+        txn->status = TransactionStatus::COMMITTED;
+        for (const auto& [variableId, writeInfo] : txn->writeSet) {
+            variableCommitHistory[variableId].push_back({txn->id, endTime});
+        }
     }
     
-    if (violatesReadWriteCycle(txn)) {
-        abort(txn, "RW-cycle");
+    if (abortReason) {
+        abort(txn, abortReason);
         return;
     }
     
@@ -455,68 +634,161 @@ void TransactionManager::end(const std::string& transactionId) {
 }
 
 void TransactionManager::commit(std::shared_ptr<Transaction> txn) {
-    txn->commitTime = currentTimestamp;
-    txn->status = TransactionStatus::COMMITTED;
-    
+    SiteSet commitSites;
     for (int siteId : txn->writeSites) {
         if (siteStates[siteId].isUp) {
-            dataManagers[siteId]->commitWrites(txn->id, currentTimestamp);
+            commitSites.insert(siteId);
         }
     }
+    sitePool.runOnSites(commitSites, [&](int siteId) {
+        dataManagers.at(siteId)->commitWrites(txn->id, txn->commitTime);
+    });
     
-    for (const auto& [variableId, writeInfo] : txn->writeSet) {
-        variableCommitHistory[variableId].push_back({txn->id, currentTimestamp});
+    // Replicas that recovered after the write missed this commit
+    if (recoveryMode == RecoveryMode::CATCH_UP) {
+        for (const auto& [variableId, writeInfo] : txn->writeSet) {
+            if (!isReplicatedVariable(variableId)) {
+                continue;
+            }
+            for (int siteId : getVariableSites(variableId)) {
+                if (siteStates[siteId].isUp && !writeInfo.sitesApplied.contains(siteId)) {
+                    dataManagers[siteId]->markHistoryIncomplete(variableId);
+                    catchUpVariable(siteId, variableId);
+                }
+            }
+        }
     }
     
+    releaseOutstandingReads(txn);
     committedTransactions.push_back(txn);
+    if (!committedById[txn->id]) {
+        committedById[txn->id] = txn;
+    }
+    liveById[txn->id] = nullptr;
     transactions.erase(txn->id);
     
-    std::cout << txn->id << " commits" << std::endl;
+    Event event(EventType::COMMIT, currentTimestamp.now());
+    event.transaction = txn->name;
+    if (walConfig.durability == DurabilityLevel::GROUP && !commitSites.empty()) {
+        heldEvents.push_back(std::move(event));
+        if (++unsyncedGroupCommits >= walConfig.groupCommitSize) {
+            syncCommitGroup();
+        }
+    } else {
+        emit(std::move(event));
+    }
+    
+    collectGarbage();
+    
+    if (walConfig.durability != DurabilityLevel::OFF && walConfig.checkpointInterval > 0 &&
+        ++commitsSinceCheckpoint >= walConfig.checkpointInterval) {
+        checkpoint();
+    }
 }
 
 void TransactionManager::abort(std::shared_ptr<Transaction> txn, const std::string& reason) {
     txn->status = TransactionStatus::ABORTED;
     
-    for (int siteId : txn->writeSites) {
-        dataManagers[siteId]->abortWrites(txn->id);
-    }
+    sitePool.runOnSites(txn->writeSites, [&](int siteId) {
+        dataManagers.at(siteId)->abortWrites(txn->id);
+    });
     
+    liveById[txn->id] = nullptr;
     transactions.erase(txn->id);
+    removeFromReaderIndex(txn);
+    releaseOutstandingReads(txn);
+    
+    Event event(EventType::ABORT, currentTimestamp.now());
+    event.transaction = txn->name;
+    event.detail = reason;
+    emit(std::move(event));
     
-    std::cout << txn->id << " aborts (" << reason << ")" << std::endl;
+    collectGarbage();
 }
 
 // SITE MANAGEMENT
 
 void TransactionManager::fail(int siteId) {
-    currentTimestamp++;
-    std::cout << "Site " << siteId << " fails" << std::endl;
-    siteStates[siteId].fail(currentTimestamp);
-    dataManagers[siteId]->onFailure();
+    Event event(EventType::SITE_FAIL, currentTimestamp.tick());
+    event.site = siteId;
+    emit(std::move(event));
+    siteStates[siteId].fail(currentTimestamp.now());
+    sitePool.runOnSite(siteId, [&](int site) {
+        dataManagers.at(site)->onFailure();
+    });
+    saveSiteStates();
 }
 
 void TransactionManager::recover(int siteId) {
-    currentTimestamp++;
-    std::cout << "Site " << siteId << " recovers" << std::endl;
-    siteStates[siteId].recover(currentTimestamp);
-    dataManagers[siteId]->onRecovery(currentTimestamp);
+    Event event(EventType::SITE_RECOVER, currentTimestamp.tick());
+    event.site = siteId;
+    emit(std::move(event));
+    siteStates[siteId].recover(currentTimestamp.now());
+    sitePool.runOnSite(siteId, [&](int site) {
+        dataManagers.at(site)->onRecovery(currentTimestamp.now());
+    });
+    saveSiteStates();
+    if (recoveryMode == RecoveryMode::CATCH_UP) {
+        catchUpSite(siteId);
+    }
     retryWaitingTransactions(siteId);
 }
 
+int TransactionManager::catchUpVariable(int siteId, int variableId) {
+    for (int peerId : getVariableSites(variableId)) {
+        if (peerId == siteId || !siteStates[peerId].isUp || 
+            !dataManagers[peerId]->hasCompleteHistory(variableId)) {
+            continue;
+        }
+        
+        std::vector<Version> delta = dataManagers[peerId]->getVersionsAfter(
+            variableId, dataManagers[siteId]->getLatestCommitTime(variableId));
+        dataManagers[siteId]->applyCatchUp(variableId, delta);
+        return static_cast<int>(delta.size());
+    }
+    return -1;
+}
+
+void TransactionManager::catchUpSite(int siteId) {
+    auto& recovering = dataManagers[siteId];
+    int replicated = 0;
+    int caughtUp = 0;
+    int copied = 0;
+    
+    for (int variableId : getVariablesAtSite(siteId)) {
+        if (!isReplicatedVariable(variableId) || recovering->isReplicaReadable(variableId)) {
+            continue;
+        }
+        replicated++;
+        
+        int versions = catchUpVariable(siteId, variableId);
+        if (versions >= 0) {
+            caughtUp++;
+            copied += versions;
+        }
+    }
+    
+    Event event(EventType::SITE_CATCH_UP, currentTimestamp.now());
+    event.site = siteId;
+    event.count = caughtUp;
+    event.total = replicated;
+    event.value = copied;
+    emit(std::move(event));
+}
+
 void TransactionManager::retryWaitingTransactions(int recoveredSiteId) {
-    std::vector<std::string> toRetry;
+    std::vector<TxnId> toRetry;
     
     for (auto& [txnId, txn] : transactions) {
         if (txn->status == TransactionStatus::WAITING) {
-            if (txn->waitInfo.candidateSites.find(recoveredSiteId) != 
-                txn->waitInfo.candidateSites.end()) {
+            if (txn->waitInfo.candidateSites.contains(recoveredSiteId)) {
                 
                 int variableId = txn->waitInfo.variableId;
                 
-                if (isOddVariable(variableId)) {
+                if (!isReplicatedVariable(variableId)) {
                     toRetry.push_back(txnId);
                 } else {
-                    std::set<int> validSites = computeValidSnapshotSites(txn, variableId);
+                    SiteSet validSites = computeValidSnapshotSites(txn, variableId);
                     if (!validSites.empty()) {
                         toRetry.push_back(txnId);
                     }
@@ -525,14 +797,17 @@ void TransactionManager::retryWaitingTransactions(int recoveredSiteId) {
         }
     }
     
-    for (const std::string& txnId : toRetry) {
+    for (TxnId txnId : toRetry) {
         auto txn = transactions[txnId];
         int variableId = txn->waitInfo.variableId;
         
-        std::cout << "Retry: " << txnId << std::endl;
+        Event event(EventType::RETRY, currentTimestamp.now());
+        event.transaction = txn->name;
+        event.variable = variableId;
+        emit(std::move(event));
         txn->resumeFromWaiting();
         
-        if (isOddVariable(variableId)) {
+        if (!isReplicatedVariable(variableId)) {
             readFromHomeSite(txn, variableId);
         } else {
             readReplicated(txn, variableId);
@@ -540,25 +815,251 @@ void TransactionManager::retryWaitingTransactions(int recoveredSiteId) {
     }
 }
 
-void TransactionManager::dump() {
-    currentTimestamp++;
-    std::cout << "\n=== DUMP ===" << std::endl;
+// GARBAGE COLLECTION
+
+int TransactionManager::computeLowWaterMark() const {
+    int lowWaterMark = currentTimestamp.now();
+    for (const auto& [txnId, txn] : transactions) {
+        lowWaterMark = std::min(lowWaterMark, txn->startTime);
+    }
+    return lowWaterMark;
+}
+
+void TransactionManager::collectGarbage() {
+    int lowWaterMark = computeLowWaterMark();
+    if (lowWaterMark <= lastGcWaterMark) {
+        return;
+    }
+    lastGcWaterMark = lowWaterMark;
+    
+    sitePool.runOnSites(allSiteIds, [&](int siteId) {
+        dataManagers.at(siteId)->collectGarbage(lowWaterMark);
+    });
+    retireCommittedTransactions(lowWaterMark);
+}
+
+int TransactionManager::computeRetirementHorizon(int lowWaterMark) const {
+    int horizon = lowWaterMark;
+    for (auto it = committedTransactions.rbegin(); it != committedTransactions.rend(); ++it) {
+        if ((*it)->commitTime < horizon) {
+            break;
+        }
+        horizon = std::min(horizon, (*it)->startTime);
+    }
+    return horizon;
+}
+
+void TransactionManager::retireCommittedTransactions(int lowWaterMark) {
+    int horizon = computeRetirementHorizon(lowWaterMark);
+    
+    auto retiredEnd = committedTransactions.begin();
+    while (retiredEnd != committedTransactions.end() && 
+           (*retiredEnd)->commitTime < horizon) {
+        ++retiredEnd;
+    }
     
-    for (int siteId = 1; siteId <= NUM_SITES; siteId++) {
-        std::cout << "site " << siteId << " - ";
-        auto state = dataManagers[siteId]->getCommittedState();
+    if (retiredEnd == committedTransactions.begin()) {
+        return;
+    }
+    
+    std::set<TxnId> reindex;
+    
+    for (auto it = committedTransactions.begin(); it != retiredEnd; ++it) {
+        const auto& retired = *it;
+        
+        if (committedById[retired->id] == retired) {
+            committedById[retired->id] = nullptr;
+            reindex.insert(retired->id);
+        }
+    }
+    
+    for (auto it = committedTransactions.begin(); it != retiredEnd; ++it) {
+        const auto& retired = *it;
         
-        bool first = true;
-        for (int varId = 1; varId <= NUM_VARIABLES; varId++) {
-            if (state.find(varId) != state.end()) {
-                if (!first) std::cout << ", ";
-                std::cout << "x" << varId << ": " << state[varId];
-                first = false;
+        removeFromReaderIndex(retired);
+        
+        for (TxnId toTxnId : retired->outgoingReadWriteConflicts) {
+            if (Transaction* to = findTransaction(toTxnId)) {
+                to->incomingReadWriteConflicts.erase(retired->id);
+            }
+        }
+        for (TxnId fromTxnId : retired->incomingReadWriteConflicts) {
+            if (Transaction* from = findTransaction(fromTxnId)) {
+                from->outgoingReadWriteConflicts.erase(retired->id);
+            }
+        }
+        
+        for (const auto& [variableId, writeInfo] : retired->writeSet) {
+            auto historyIt = variableCommitHistory.find(variableId);
+            if (historyIt == variableCommitHistory.end()) {
+                continue;
             }
+            auto& history = historyIt->second;
+            history.erase(std::remove_if(history.begin(), history.end(),
+                [horizon](const std::pair<TxnId, int>& entry) { 
+                    return entry.second < horizon; 
+                }), history.end());
+            if (history.empty()) {
+                variableCommitHistory.erase(historyIt);
+            }
+        }
+    }
+    
+    committedTransactions.erase(committedTransactions.begin(), retiredEnd);
+    
+    // A reused name may still have a later committed incarnation
+    for (const auto& txn : committedTransactions) {
+        if (reindex.count(txn->id) && !committedById[txn->id]) {
+            committedById[txn->id] = txn;
+        }
+    }
+}
+
+void TransactionManager::checkpoint() {
+    sitePool.runOnSites(allSiteIds, [&](int siteId) {
+        dataManagers.at(siteId)->checkpoint();
+    });
+    saveSiteStates();
+    commitsSinceCheckpoint = 0;
+}
+
+void TransactionManager::syncCommitGroup() {
+    if (heldEvents.empty()) {
+        return;
+    }
+    
+    sitePool.runOnSites(allSiteIds, [&](int siteId) {
+        dataManagers.at(siteId)->syncLog();
+    });
+    unsyncedGroupCommits = 0;
+    
+    for (Event& event : heldEvents) {
+        events->emit(std::move(event));
+    }
+    heldEvents.clear();
+}
+
+void TransactionManager::saveSiteStates() {
+    if (walConfig.durability == DurabilityLevel::OFF) {
+        return;
+    }
+    
+    SnapshotWriter writer(SITE_STATES_MAGIC);
+    writer.put(currentTimestamp.now());
+    writer.put(getNumSites());
+    for (const auto& [siteId, state] : siteStates) {
+        writer.put(static_cast<int>(state.isUp));
+        writer.put(state.lastRecoveryTime);
+        writer.put(static_cast<uint32_t>(state.failureHistory.size()));
+        for (const auto& interval : state.failureHistory) {
+            writer.put(interval.failTime);
+            writer.put(interval.recoverTime);
+        }
+    }
+    writer.commit(walConfig.directory + "/sites.ckpt");
+}
+
+void TransactionManager::loadSiteStates() {
+    std::string path = walConfig.directory + "/sites.ckpt";
+    MappedSnapshot snapshot(path, SITE_STATES_MAGIC);
+    if (!snapshot.exists()) {
+        return;
+    }
+    
+    int savedClock = 0;
+    int numSites = 0;
+    bool ok = snapshot.isValid() && snapshot.get(savedClock) && 
+              snapshot.get(numSites) && numSites == getNumSites();
+    
+    for (auto& [siteId, state] : siteStates) {
+        int isUp = 1;
+        uint32_t count = 0;
+        ok = ok && snapshot.get(isUp) && snapshot.get(state.lastRecoveryTime) && 
+             snapshot.get(count);
+        if (!ok) {
+            break;
         }
-        std::cout << std::endl;
+        
+        state.isUp = isUp != 0;
+        state.failureHistory.clear();
+        for (uint32_t i = 0; i < count && ok; i++) {
+            FailureInterval interval(0);
+            ok = snapshot.get(interval.failTime) && snapshot.get(interval.recoverTime);
+            state.failureHistory.push_back(interval);
+        }
+    }
+    
+    if (!ok) {
+        throw std::runtime_error("Site state file " + path + 
+                                 " is corrupt or was written for a different catalog");
+    }
+    
+    currentTimestamp.advanceTo(savedClock);
+    for (const auto& [siteId, state] : siteStates) {
+        if (!state.failureHistory.empty()) {
+            dataManagers[siteId]->forgetCompleteHistory();
+        }
+        if (!state.isUp) {
+            dataManagers[siteId]->onFailure();
+        }
+    }
+}
+
+long long TransactionManager::getReclaimedVersionCount() const {
+    long long total = 0;
+    for (const auto& [siteId, dm] : dataManagers) {
+        total += dm->getReclaimedVersionCount();
+    }
+    return total;
+}
+
+long long TransactionManager::getReclaimedBytes() const {
+    long long total = 0;
+    for (const auto& [siteId, dm] : dataManagers) {
+        total += dm->getReclaimedBytes();
+    }
+    return total;
+}
+
+bool TransactionManager::checkVariable(int variableId) {
+    if (variableId >= 1 && variableId <= getNumVariables()) {
+        return true;
     }
-    std::cout << "============\n" << std::endl;
+    Event event(EventType::UNKNOWN_VARIABLE, currentTimestamp.now());
+    event.variable = variableId;
+    emit(std::move(event));
+    return false;
+}
+
+void TransactionManager::dump() {
+    Event event(EventType::DUMP, currentTimestamp.tick());
+    
+    for (int siteId = 1; siteId <= getNumSites(); siteId++) {
+        event.dump.push_back({siteId, dataManagers[siteId]->getCommittedState()});
+    }
+    emit(std::move(event));
+}
+
+void TransactionManager::setEventSink(std::unique_ptr<EventSink> sink) {
+    syncCommitGroup();
+    events->flush();
+    events = std::move(sink);
+}
+
+void TransactionManager::reportCommandError(const std::string& message) {
+    Event event(EventType::COMMAND_ERROR, currentTimestamp.now());
+    event.detail = message;
+    emit(std::move(event));
+}
+
+void TransactionManager::emitRead(const Transaction& txn, int variableId, int value, 
+                                  int siteId) {
+    Event event(EventType::READ, currentTimestamp.now());
+    event.transaction = txn.name;
+    event.variable = variableId;
+    event.value = value;
+    event.site = siteId;
+    emit(std::move(event));
 }
 
 } // namespace RepCRec
@@ -11,7 +11,12 @@
 #include "DataManager.h"
 #include "SiteState.h"
 #include "Constants.h"
+#include "TransactionIdTable.h"
+#include "SiteWorkerPool.h"
+#include "TimestampOracle.h"
+#include "EventSink.h"
 #include <map>
+#include <mutex>
 #include <vector>
 #include <memory>
 #include <set>
@@ -21,16 +26,69 @@ namespace RepCRec {
 
 class TransactionManager {
 private:
-    int currentTimestamp;
-    std::map<std::string, std::shared_ptr<Transaction>> transactions;
+    TimestampOracle currentTimestamp;  // atomic so site workers may read it
+    ValidationMode validationMode;
+    RecoveryMode recoveryMode;
+    
+    // Replica choice for replicated reads, and per-site load it is based on
+    ReplicaSelection replicaSelection;
+    int nextReplicaSite;                           // ROUND_ROBIN cursor
+    std::vector<long long> readsServedBySite;      // siteId -> reads ever served
+    std::vector<int> outstandingReadsBySite;       // siteId -> reads held by live txns
+    TransactionIdTable transactionIds;  // name <-> TxnId, names used only for output
+    std::map<TxnId, std::shared_ptr<Transaction>> transactions;
     std::vector<std::shared_ptr<Transaction>> committedTransactions;
+    int lastGcWaterMark;  // low-water mark of the last collectGarbage() pass
+    
+    // Dense TxnId -> Transaction indexes for O(1) lookup during graph traversal
+    std::vector<std::shared_ptr<Transaction>> liveById;       // active or waiting
+    std::vector<std::shared_ptr<Transaction>> committedById;  // first committed incarnation
     std::map<int, std::shared_ptr<DataManager>> dataManagers;  // siteId -> DataManager
     std::map<int, SiteState> siteStates;  // siteId -> SiteState
     
+    // Runs reads, buffered writes, commit/abort, GC and checkpoints at each 
+    // site (on per-site workers under SITE_THREADS). Every call waits for its 
+    // batch, so between batches the TM may inspect DataManagers directly. 
+    // Declared after dataManagers so the workers are joined first.
+    SiteWorkerPool sitePool;
+    SiteSet allSiteIds;
+    
+    // Live and unretired committed transactions that read each variable, so
+    // createRWEdgesForCommit only visits actual readers
+    std::map<int, std::vector<std::shared_ptr<Transaction>>> readersByVariable;
+    // variableId -> readers in order of first read
+    
     // Track commit history per variable for FCW
-    std::map<int, std::vector<std::pair<std::string, int>>> variableCommitHistory;
+    std::map<int, std::vector<std::pair<TxnId, int>>> variableCommitHistory;
     // variableId -> list of (transactionId, commitTime)
     
+    // Durability settings and commits since the last checkpoint
+    WalConfig walConfig;
+    int commitsSinceCheckpoint;
+    
+    // Every operation's outcome is reported here (TextEventSink on std::cout 
+    // unless setEventSink() replaced it)
+    std::unique_ptr<EventSink> events;
+    
+    // Under GROUP durability: events held back since the first commit that is 
+    // not yet fsync'd, and the number of such commits (see syncCommitGroup())
+    std::vector<Event> heldEvents;
+    int unsyncedGroupCommits;
+    
+    // Events queue behind a held commit, so output order never changes
+    void emit(Event&& event) {
+        if (!heldEvents.empty()) {
+            heldEvents.push_back(std::move(event));
+            return;
+        }
+        events->emit(std::move(event));
+    }
+    
+    void emitRead(const Transaction& txn, int variableId, int value, int siteId);
+    
+    // False (and an UNKNOWN_VARIABLE event) unless 1 <= variableId <= getNumVariables()
+    bool checkVariable(int variableId);
+    
 public:
     // ========================================================================
     // CONSTRUCTOR
@@ -39,18 +97,39 @@ public:
     /**
      * TransactionManager Constructor
      * Author: Aishwarya Anand
-     * Input: None (constructor)
+     * Input:
+     *   - mode (ValidationMode): How end() checks for dangerous RW structures 
+     *                            (defaults to the full-graph STRICT_GRAPH check)
+     *   - walConfig (WalConfig): Per-site write-ahead log settings (default: 
+     *                            durability OFF, nothing touches disk)
+     *   - recovery (RecoveryMode): How recovered sites become readable again 
+     *                              (defaults to READ_GATE)
+     *   - selection (ReplicaSelection): Replica choice for replicated reads 
+     *                                   (defaults to LOWEST_SITE)
+     *   - execution (ExecutionMode): DETERMINISTIC (default) or one worker 
+     *                                thread per site; output is identical
      * Output: None
      * Description: Initializes the TransactionManager with timestamp set to 0,
-     *              creates 10 DataManager instances (one per site), and 
-     *              initializes SiteState for each site.
+     *              creates getNumSites() DataManager instances (one per site), 
+     *              and initializes SiteState for each site. The catalog must be 
+     *              configured (configureCatalog()) before construction. When the 
+     *              sites replay an existing checkpoint and log, the site failure 
+     *              history is restored too and the clock resumes after the 
+     *              newest durable event.
      * Side Effects:
-     *   - Sets currentTimestamp to 0
-     *   - Creates and stores 10 DataManager objects in dataManagers map
-     *   - Creates and stores 10 SiteState objects in siteStates map
+     *   - Sets currentTimestamp to 0, or to the newest durable commit or 
+     *     site event time
+     *   - May mark sites down that were down when the last run ended
+     *   - Sets validationMode
+     *   - Creates and stores one DataManager per site in dataManagers map
+     *   - Creates and stores one SiteState per site in siteStates map
      *   - Each DataManager is initialized with its site variables and initial values
      */
-    TransactionManager();
+    TransactionManager(ValidationMode mode = ValidationMode::STRICT_GRAPH,
+                       const WalConfig& walConfig = WalConfig(),
+                       RecoveryMode recovery = RecoveryMode::READ_GATE,
+                       ReplicaSelection selection = ReplicaSelection::LOWEST_SITE,
+                       ExecutionMode execution = ExecutionMode::DETERMINISTIC);
     
     // ========================================================================
     // CORE TRANSACTION OPERATIONS
@@ -61,14 +140,18 @@ public:
      * Author: Aishwarya Anand
      * Input: 
      *   - transactionId (string): Unique identifier for the transaction (e.g., "T1")
-     * Output: None (prints to stdout)
+     * Output: None (reports to the event sink)
      * Description: Creates a new transaction with the given ID, assigns it the 
      *              current timestamp as its start time, and adds it to the active 
-     *              transactions map.
+     *              transactions map. The name is interned to a TxnId here; all 
+     *              internal bookkeeping uses the integer id.
      * Side Effects:
      *   - Increments currentTimestamp by 1
+     *   - Interns transactionId in transactionIds if it is new
      *   - Creates new Transaction object with current timestamp as startTime
      *   - Adds transaction to transactions map
+     *   - If a live transaction already had this name, discards it: drops its 
+     *     buffered writes, reads and RW edges from every per-variable index
      *   - Prints: "Transaction T1 begins at time X"
      */
     void begin(const std::string& transactionId);
@@ -79,7 +162,7 @@ public:
      * Input:
      *   - transactionId (string): ID of the transaction performing the read
      *   - variableId (int): Variable to read (1-20)
-     * Output: Prints variable value to stdout (e.g., "x4: 40")
+     * Output: Reports variable value to the event sink (e.g., "x4: 40")
      * Description: Reads a variable under snapshot isolation. First checks 
      *              read-your-own-write in writeSet, then routes to readFromHomeSite() 
      *              for odd variables or readReplicated() for even variables.
@@ -100,7 +183,7 @@ public:
      *   - transactionId (string): ID of the transaction performing the write
      *   - variableId (int): Variable to write (1-20)
      *   - value (int): Value to write
-     * Output: Prints sites written to stdout
+     * Output: Prints sites written to the event sink
      * Description: Buffers a write to all currently UP sites that store the variable. 
      *              Does not modify committed data until transaction commits.
      * Side Effects:
@@ -118,7 +201,7 @@ public:
      * Author: Aishwarya Anand
      * Input:
      *   - transactionId (string): ID of the transaction to end
-     * Output: Prints commit or abort message to stdout
+     * Output: Prints commit or abort message to the event sink
      * Description: Performs validation checks (failure rule, first-committer-wins, 
      *              RW-cycle) and either commits or aborts the transaction based on 
      *              validation results.
@@ -142,7 +225,7 @@ public:
      * Author: Archita Arora
      * Input:
      *   - siteId (int): ID of the site to fail (1-10)
-     * Output: Prints failure message to stdout
+     * Output: Prints failure message to the event sink
      * Description: Simulates site failure by marking the site as down, recording 
      *              the failure time, and clearing uncommitted writes at that site.
      * Side Effects:
@@ -160,7 +243,7 @@ public:
      * Author: Archita Arora
      * Input:
      *   - siteId (int): ID of the site to recover (1-10)
-     * Output: Prints recovery message to stdout
+     * Output: Prints recovery message to the event sink
      * Description: Brings a failed site back online, closes the failure interval, 
      *              enables the read gate mechanism for replicated variables, and 
      *              retries waiting transactions.
@@ -169,8 +252,9 @@ public:
      *   - Marks site as up in siteStates
      *   - Records recovery time in siteStates[siteId].failureHistory
      *   - Sets lastRecoveryTime in siteStates
-     *   - Calls DataManager.onRecovery() which sets replicaReadEnabled[x] = false 
-     *     for replicated variables
+     *   - Calls DataManager.onRecovery() which closes the read gate of every 
+     *     replicated variable at the site
+     *   - Under RecoveryMode::CATCH_UP, calls catchUpSite() first
      *   - Calls retryWaitingTransactions() which may resume blocked transactions
      *   - Prints: "Site X recovers" and possibly "Retry: T1" messages
      */
@@ -184,7 +268,7 @@ public:
      * dump - Print database state
      * Author: Aishwarya Anand
      * Input: None
-     * Output: Prints committed state of all variables at all sites to stdout
+     * Output: Prints committed state of all variables at all sites to the event sink
      * Description: Prints the current committed values of all variables at each site 
      *              in ascending order by variable ID. Includes down sites showing 
      *              their last committed state.
@@ -199,6 +283,89 @@ public:
      */
     void dump();
     
+    /**
+     * getReclaimedVersionCount - Versions pruned by garbage collection
+     * Author: Aishwarya Anand
+     * Input: None
+     * Output: long long - Sum of reclaimed versions across all sites
+     * Description: Aggregates DataManager::getReclaimedVersionCount() over all 
+     *              sites. Exposed for monitoring; not printed by any command.
+     * Side Effects: None (read-only)
+     */
+    long long getReclaimedVersionCount() const;
+    
+    /**
+     * getReclaimedBytes - Memory released by garbage collection
+     * Author: Archita Arora
+     * Input: None
+     * Output: long long - Sum of reclaimed bytes across all sites
+     * Description: Aggregates DataManager::getReclaimedBytes() over all sites.
+     * Side Effects: None (read-only)
+     */
+    long long getReclaimedBytes() const;
+    
+    /**
+     * getReadsServedBySite - Per-site read counters
+     * Author: Aishwarya Anand
+     * Input: None
+     * Output: vector<long long> - Index siteId holds the number of reads 
+     *         (replicated and home-site) served there; index 0 is unused
+     * Description: Lets callers check how evenly the replica selection policy 
+     *              spreads read load. Printed by main with --read-stats.
+     * Side Effects: None (read-only)
+     */
+    const std::vector<long long>& getReadsServedBySite() const {
+        return readsServedBySite;
+    }
+    
+    // ========================================================================
+    // OUTPUT
+    // ========================================================================
+    
+    /**
+     * setEventSink - Choose where operation outcomes are reported
+     * Author: Archita Arora
+     * Input:
+     *   - sink (unique_ptr<EventSink>): e.g. from makeEventSink(); text to 
+     *                                   std::cout is the default
+     * Output: None
+     * Description: Events already handed to the old sink are flushed before 
+     *              it is replaced, so output order is kept across the switch.
+     * Side Effects: Destroys the previous sink
+     */
+    void setEventSink(std::unique_ptr<EventSink> sink);
+    
+    // Wait until every event reported so far has been written (call before
+    // writing to the same stream directly, as main does for its summary).
+    // Closes an open GROUP commit group first, so held commits are reported.
+    void flushEvents() {
+        syncCommitGroup();
+        events->flush();
+    }
+    
+    /**
+     * syncCommitGroup - Make the held commits durable, then report them
+     * Author: Archita Arora
+     * Input: None
+     * Output: None
+     * Description: Under GROUP durability a commit that logged writes is not 
+     *              reported when it is applied: its COMMIT event, and every 
+     *              event after it, waits in heldEvents. Once 
+     *              walConfig.groupCommitSize such commits are waiting, or 
+     *              the Parser has run every command read so far and is about 
+     *              to wait for input, or output is flushed, every site's log 
+     *              is fsync'd and the held events are emitted in order. A 
+     *              crash can therefore lose a whole group, but never a commit 
+     *              already reported. No-op when nothing is held.
+     * Side Effects:
+     *   - fsyncs every site log with unsynced records
+     *   - Emits and clears heldEvents; resets unsyncedGroupCommits
+     */
+    void syncCommitGroup();
+    
+    // Report a malformed script line in order with the operation output
+    void reportCommandError(const std::string& message);
+    
 private:
     // ========================================================================
     // READ OPERATIONS (PRIVATE HELPERS)
@@ -210,7 +377,7 @@ private:
      * Input:
      *   - txn (shared_ptr<Transaction>): Transaction performing the read
      *   - variableId (int): Unreplicated variable to read
-     * Output: None (prints to stdout)
+     * Output: None (reports to the event sink)
      * Description: Reads an unreplicated (odd-indexed) variable from its unique 
      *              home site. If the site is down, puts the transaction in WAITING state.
      * Side Effects:
@@ -229,7 +396,7 @@ private:
      * Input:
      *   - txn (shared_ptr<Transaction>): Transaction performing the read
      *   - variableId (int): Replicated variable to read
-     * Output: None (prints to stdout)
+     * Output: None (reports to the event sink)
      * Description: Reads a replicated (even-indexed) variable from any site with 
      *              a valid snapshot. Computes valid sites, waits if needed, or 
      *              aborts if no valid snapshot exists.
@@ -244,6 +411,46 @@ private:
      */
     void readReplicated(std::shared_ptr<Transaction> txn, int variableId);
     
+    /**
+     * chooseReplica - Apply the replica selection policy
+     * Author: Archita Arora
+     * Input:
+     *   - txn (shared_ptr<Transaction>): Transaction issuing the read
+     *   - validSites (SiteSet): Non-empty set of sites with a valid snapshot
+     * Output: int - Site that serves the read
+     * Description: LOWEST_SITE takes the first valid site. ROUND_ROBIN takes 
+     *              the first valid site at or after a rotating cursor. 
+     *              LEAST_OUTSTANDING takes the site with the fewest reads held 
+     *              by in-flight transactions, breaking ties by fewest reads 
+     *              served. AFFINITY reuses a site the transaction already 
+     *              accessed (fewer sites whose failure can abort it), else the 
+     *              first valid site at or after 1 + (txn id mod site count).
+     * Side Effects: Advances nextReplicaSite under ROUND_ROBIN
+     */
+    int chooseReplica(const std::shared_ptr<Transaction>& txn, const SiteSet& validSites);
+    
+    /**
+     * recordSiteRead - Account one read served by a site
+     * Author: Aishwarya Anand
+     * Input:
+     *   - siteId (int): Serving site
+     *   - firstReadOfVariable (bool): True if the read added a readSet entry, 
+     *                                 which stays outstanding until end()
+     * Output: None
+     * Side Effects: Updates readsServedBySite and outstandingReadsBySite
+     */
+    void recordSiteRead(int siteId, bool firstReadOfVariable);
+    
+    /**
+     * releaseOutstandingReads - Drop a finished transaction's read load
+     * Author: Archita Arora
+     * Input:
+     *   - txn (shared_ptr<Transaction>): Committed, aborted or superseded transaction
+     * Output: None
+     * Side Effects: Decrements outstandingReadsBySite for each readSet entry
+     */
+    void releaseOutstandingReads(const std::shared_ptr<Transaction>& txn);
+    
     // ========================================================================
     // VALIDATION AT COMMIT TIME
     // ========================================================================
@@ -282,7 +489,8 @@ private:
      * Output: Boolean (true if dangerous cycle detected, false otherwise)
      * Description: Detects dangerous structures (cycles with 2+ consecutive RW edges) 
      *              by first creating RW edges for this commit, then checking for 
-     *              cycles using DFS and BFS.
+     *              cycles using DFS and BFS. In PIVOT_FLAGS mode the graph search 
+     *              is replaced by isDangerousPivot().
      * Side Effects:
      *   - Calls createRWEdgesForCommit() which modifies incomingReadWriteConflicts 
      *     and outgoingReadWriteConflicts of transaction objects
@@ -290,6 +498,26 @@ private:
      */
     bool violatesReadWriteCycle(std::shared_ptr<Transaction> txn);
     
+    /**
+     * isDangerousPivot - Incremental SSI check using conflict flags
+     * Author: Archita Arora
+     * Input:
+     *   - txn (shared_ptr<Transaction>): Transaction to validate (edges for this 
+     *                                    commit already created)
+     * Output: Boolean (true if txn must abort, false otherwise)
+     * Description: Outgoing RW edges are only ever created when the writer 
+     *              commits, so a transaction with an out-conflict always points at 
+     *              a T_out that committed first. If txn also has an in-conflict it 
+     *              is the pivot of T_in -rw-> txn -rw-> T_out. When every T_in is 
+     *              still live, they are doomed and txn commits (the pivot's 
+     *              work survives, as in test 22); if any T_in has already 
+     *              committed (or retired), txn aborts. A transaction doomed 
+     *              earlier always aborts.
+     * Side Effects:
+     *   - Sets doomed on the live T_in transactions when txn may commit
+     */
+    bool isDangerousPivot(std::shared_ptr<Transaction> txn);
+    
     // ========================================================================
     // SITE AVAILABILITY CHECKING
     // ========================================================================
@@ -300,14 +528,49 @@ private:
      * Input:
      *   - txn (shared_ptr<Transaction>): Transaction requesting the read
      *   - variableId (int): Variable to read
-     * Output: Set of site IDs that can serve valid snapshots
+     * Output: SiteSet of site IDs that can serve valid snapshots
      * Description: Determines which sites have a valid snapshot for the transaction 
      *              by checking if they: (1) are currently UP, (2) have a committed 
      *              version from before transaction start, (3) were up continuously 
-     *              from that commit to transaction start.
+     *              from that commit to transaction start. Under CATCH_UP, a site 
+     *              whose history of the variable is complete (caught up, or 
+     *              never failed) meets (3) regardless of its failures.
      * Side Effects: None (read-only computation)
      */
-    std::set<int> computeValidSnapshotSites(std::shared_ptr<Transaction> txn, int variableId);
+    SiteSet computeValidSnapshotSites(std::shared_ptr<Transaction> txn, int variableId);
+    
+    /**
+     * catchUpSite - Copy versions a recovered site missed from its peers
+     * Author: Aishwarya Anand
+     * Input:
+     *   - siteId (int): Site that just recovered
+     * Output: None
+     * Description: For each replicated variable whose gate is closed at the 
+     *              site, picks an up peer with a complete history of it and 
+     *              copies the versions committed after the site's newest local 
+     *              one, which reopens the gate. A variable with no such peer 
+     *              stays gated until its next write, as under READ_GATE.
+     * Side Effects:
+     *   - Appends versions (and log records) at the recovered site
+     *   - Prints "Site X catches up N/M replicated variables (K versions)"
+     * Note: commit() keeps caught-up replicas current afterwards: a commit 
+     *       that skips an up replica (down when the variable was written) 
+     *       marks it incomplete and catches it up on the spot.
+     */
+    void catchUpSite(int siteId);
+    
+    /**
+     * catchUpVariable - Bring one replica of a variable up to date
+     * Author: Archita Arora
+     * Input:
+     *   - siteId (int): Up site whose replica is stale
+     *   - variableId (int): Replicated variable to copy
+     * Output: int - Versions copied, or -1 if no up peer has a complete history
+     * Description: Copies from the first such peer the versions committed 
+     *              after the site's newest local one.
+     * Side Effects: Calls DataManager::applyCatchUp() on success
+     */
+    int catchUpVariable(int siteId, int variableId);
     
     /**
      * wasSiteUpContinuously - Check continuous site availability
@@ -334,8 +597,9 @@ private:
      *   - txn (shared_ptr<Transaction>): Transaction that is committing
      * Output: None
      * Description: Creates read-write anti-dependency edges from all transactions 
-     *              that read variables this transaction is writing. Checks both 
-     *              active and committed transactions.
+     *              that read variables this transaction is writing. Only visits 
+     *              the readers recorded in readersByVariable, which 
+     *              covers both active and (unretired) committed transactions. 
      * Side Effects:
      *   - Updates outgoingReadWriteConflicts of reading transactions
      *   - Updates incomingReadWriteConflicts of the committing transaction
@@ -343,35 +607,62 @@ private:
      */
     void createRWEdgesForCommit(std::shared_ptr<Transaction> txn);
     
+    /**
+     * removeFromReaderIndex - Unregister a transaction as a reader
+     * Author: Aishwarya Anand
+     * Input:
+     *   - txn (shared_ptr<Transaction>): Aborted, superseded or retired transaction
+     * Output: None
+     * Description: Removes txn from readersByVariable for every variable in its 
+     *              readSet, so it no longer contributes RW edges.
+     * Side Effects:
+     *   - Erases entries (and empty lists) from readersByVariable
+     */
+    void removeFromReaderIndex(const std::shared_ptr<Transaction>& txn);
+    
     /**
      * hasRWCyclePath - DFS-based cycle detection
      * Author: Aishwarya Anand
      * Input:
-     *   - fromTxnId (string): Starting transaction for DFS
-     *   - targetTxnId (string): Target transaction (cycle detection)
+     *   - fromTxnId (TxnId): Starting transaction for DFS
+     *   - targetTxnId (TxnId): Target transaction (cycle detection)
      *   - edgeCount (int): Number of edges traversed so far
-     *   - visited (set<string>&): Set of visited transaction IDs
+     *   - visited (set<TxnId>&): Set of visited transaction IDs
      * Output: Boolean (true if cycle with ≥2 edges found, false otherwise)
      * Description: Performs depth-first search to detect cycles in the RW conflict 
      *              graph, ensuring the cycle contains at least 2 RW edges.
      * Side Effects:
      *   - Modifies visited set during traversal
-     *   - Traverses both active transactions and committedTransactions
+     *   - Resolves each visited id through findTransaction()
      */
-    bool hasRWCyclePath(const std::string& fromTxnId, const std::string& targetTxnId, int edgeCount, std::set<std::string>& visited);
+    bool hasRWCyclePath(TxnId fromTxnId, TxnId targetTxnId, int edgeCount, std::set<TxnId>& visited);
     
     /**
      * hasPathViaRW - BFS-based path finding
      * Author: Archita Arora
      * Input:
-     *   - fromTxnId (string): Source transaction
-     *   - toTxnId (string): Destination transaction
+     *   - fromTxnId (TxnId): Source transaction
+     *   - toTxnId (TxnId): Destination transaction
      * Output: Boolean (true if path exists, false otherwise)
      * Description: Uses breadth-first search to check if there exists any path 
      *              through RW edges from source to destination transaction.
      * Side Effects: Creates temporary visited set and queue for BFS traversal
      */
-    bool hasPathViaRW(const std::string& fromTxnId, const std::string& toTxnId);
+    bool hasPathViaRW(TxnId fromTxnId, TxnId toTxnId);
+    
+    /**
+     * findTransaction - O(1) lookup of a transaction by id
+     * Author: Aishwarya Anand
+     * Input:
+     *   - txnId (TxnId): Transaction to look up
+     * Output: Transaction* - The live transaction with this id if there is one, 
+     *         otherwise the first committed transaction with this id, otherwise 
+     *         nullptr (aborted or unknown)
+     * Description: Indexes liveById and committedById directly, replacing the 
+     *              linear scan over committedTransactions in graph traversals.
+     * Side Effects: None (read-only lookup)
+     */
+    Transaction* findTransaction(TxnId txnId) const;
     
     // ========================================================================
     // COMMIT/ABORT OPERATIONS
@@ -382,14 +673,13 @@ private:
      * Author: Aishwarya Anand
      * Input:
      *   - txn (shared_ptr<Transaction>): Transaction to commit
-     * Output: None (prints to stdout)
+     * Output: None (reports to the event sink)
      * Description: Commits the transaction by persisting all buffered writes to 
-     *              DataManagers, updating commit history, and moving transaction 
-     *              to committedTransactions list.
+     *              DataManagers and moving transaction to committedTransactions 
+     *              list. end() has already stamped it COMMITTED and recorded it 
+     *              in variableCommitHistory.
      * Side Effects:
-     *   - Sets transaction commitTime and status to COMMITTED
      *   - Calls DataManager.commitWrites() at all UP sites in writeSites
-     *   - Updates variableCommitHistory for all written variables
      *   - Moves transaction from transactions to committedTransactions
      *   - Removes transaction from active transactions map
      *   - Prints: "T1 commits"
@@ -402,7 +692,7 @@ private:
      * Input:
      *   - txn (shared_ptr<Transaction>): Transaction to abort
      *   - reason (string): Reason for abort (e.g., "Site failure", "RW-cycle")
-     * Output: None (prints to stdout)
+     * Output: None (reports to the event sink)
      * Description: Aborts the transaction by discarding all buffered writes at 
      *              DataManagers and removing the transaction from active transactions.
      * Side Effects:
@@ -434,6 +724,130 @@ private:
      *   - May complete reads and update transaction state
      */
     void retryWaitingTransactions(int recoveredSiteId);  
+    
+    // ========================================================================
+    // GARBAGE COLLECTION
+    // ========================================================================
+    
+    /**
+     * computeLowWaterMark - Oldest snapshot any transaction can still read
+     * Author: Archita Arora
+     * Input: None
+     * Output: int - Minimum startTime over live (active or waiting) transactions,
+     *               or currentTimestamp if there are none
+     * Description: Any transaction that begins later gets a startTime greater 
+     *              than currentTimestamp, so no snapshot older than this value 
+     *              will ever be requested again.
+     * Side Effects: None (read-only computation)
+     */
+    int computeLowWaterMark() const;
+    
+    /**
+     * collectGarbage - Prune obsolete versions and retired transactions
+     * Author: Aishwarya Anand
+     * Input: None
+     * Output: None
+     * Description: Computes the low-water mark, calls 
+     *              DataManager::collectGarbage() on every site, including down 
+     *              sites (their committed history is kept for recovery but the 
+     *              same visibility argument applies), and then 
+     *              retireCommittedTransactions(). Invoked whenever a 
+     *              transaction leaves the active set, since that is the only 
+     *              event that advances the watermark, and returns at once when 
+     *              the watermark has not moved past lastGcWaterMark: versions 
+     *              committed since then are newer than it, so a repeat pass 
+     *              could not drop anything.
+     * Side Effects:
+     *   - Erases unreachable versions from each DataManager's dataStore
+     *   - Shrinks committedTransactions and variableCommitHistory
+     *   - SiteState failure history is left untouched
+     */
+    void collectGarbage();
+    
+    /**
+     * computeRetirementHorizon - Oldest commit time the conflict graph still needs
+     * Author: Aishwarya Anand
+     * Input:
+     *   - lowWaterMark (int): Oldest startTime among live transactions
+     * Output: int - Committed transactions with commitTime below this can retire
+     * Description: Being older than every live startTime is not enough: in 
+     *              T3 -rw-> T2 -rw-> T1 with T1 committed before T3 began, T1 is 
+     *              still needed while T2 (concurrent with both) is in the graph. 
+     *              Walks committedTransactions from newest to oldest and lowers 
+     *              the horizon to the startTime of every committed transaction 
+     *              that overlaps it, so only transactions with no chain of 
+     *              concurrency to a live transaction are released.
+     * Side Effects: None (read-only computation)
+     */
+    int computeRetirementHorizon(int lowWaterMark) const;
+    
+    /**
+     * retireCommittedTransactions - Drop committed transactions no one can see
+     * Author: Archita Arora
+     * Input:
+     *   - lowWaterMark (int): Oldest startTime among live transactions
+     * Output: None
+     * Description: A committed transaction that finished before the retirement 
+     *              horizon is not (even transitively) concurrent with any present 
+     *              or future transaction, so it can no longer be part of a 
+     *              dangerous structure or a first-committer-wins conflict. Because 
+     *              committedTransactions is in commit order, the retired set is 
+     *              always a prefix of it.
+     * Side Effects:
+     *   - Removes the retired prefix of committedTransactions
+     *   - Removes their RW edges from the remaining transactions
+     *   - Removes them from readersByVariable
+     *   - Removes their entries from variableCommitHistory
+     *   - Repoints committedById to the next committed incarnation, if any
+     */
+    void retireCommittedTransactions(int lowWaterMark);
+    
+    // ========================================================================
+    // CHECKPOINTING
+    // ========================================================================
+    
+    /**
+     * checkpoint - Bound restart time by snapshotting every site
+     * Author: Aishwarya Anand
+     * Input: None
+     * Output: None
+     * Description: Runs after every walConfig.checkpointInterval commits. Each 
+     *              up site writes its checkpoint and truncates its log; the 
+     *              site failure history is saved alongside.
+     * Side Effects:
+     *   - Rewrites site<N>.ckpt and empties site<N>.wal for every up site
+     *   - Rewrites sites.ckpt; resets commitsSinceCheckpoint
+     */
+    void checkpoint();
+    
+    /**
+     * saveSiteStates - Persist the failure history of every site
+     * Author: Archita Arora
+     * Input: None
+     * Output: None
+     * Description: Writes sites.ckpt (clock, up/down flag, last recovery time 
+     *              and failure intervals per site). Called on every fail() and 
+     *              recover() as well as at checkpoints, so it never lags the 
+     *              in-memory history. No-op when durability is OFF.
+     * Side Effects: Atomically replaces sites.ckpt in the log directory
+     */
+    void saveSiteStates();
+    
+    /**
+     * loadSiteStates - Restore failure history saved by a previous run
+     * Author: Aishwarya Anand
+     * Input: None
+     * Output: None
+     * Description: Maps sites.ckpt if present and restores each SiteState. A 
+     *              site that was down stays down: its DataManager drops the 
+     *              store it just loaded, as if it had failed.
+     * Side Effects:
+     *   - Replaces siteStates; may call onFailure() on DataManagers
+     *   - Advances currentTimestamp to the saved clock
+     *   - Throws std::runtime_error if the file is corrupt or was written 
+     *     for a different number of sites
+     */
+    void loadSiteStates();
 };
 
 } 
@@ -1,29 +1,197 @@
 // Version.h
 // Author: Aishwarya and Archita
 // Date: December 2025
-// Purpose: Represents a single version of a variable with timestamp and writer info
-// Side effects: None - simple data class
+// Purpose: Represents versions of a variable with timestamp and writer info
+// Side effects: Version chains retire replaced blocks to the EpochDomain
 
 #ifndef VERSION_H
 #define VERSION_H
 
-#include <string>
+#include "EpochReclaimer.h"
+#include "TransactionIdTable.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
 
 namespace RepCRec {
 
+// A single materialized version (row form)
 class Version {
 public:
     int value;
     int commitTimestamp;
-    std::string writerTransactionId;
+    TxnId writerTransactionId;
     
-    Version(int val, int commitTime, const std::string& writerId)
+    Version(int val, int commitTime, TxnId writerId)
         : value(val), commitTimestamp(commitTime), writerTransactionId(writerId) {}
     
     // Default constructor for initial values (committed at time 0)
-    Version(int val) : value(val), commitTimestamp(0), writerTransactionId("INITIAL") {}
+    Version(int val) : value(val), commitTimestamp(0), writerTransactionId(INITIAL_TXN_ID) {}
+};
+
+// Fixed-capacity column storage behind a VersionChain. Slots below 
+// publishedSize are immutable; the committer fills the next slot and then 
+// bumps publishedSize, so readers never see a half-written version.
+struct VersionBlock {
+    int capacity;
+    std::atomic<int> publishedSize;
+    std::unique_ptr<int[]> commitTimestamps;
+    std::unique_ptr<int[]> values;
+    std::unique_ptr<TxnId[]> writers;
+    
+    explicit VersionBlock(int blockCapacity)
+        : capacity(blockCapacity), publishedSize(0),
+          commitTimestamps(new int[blockCapacity]), values(new int[blockCapacity]),
+          writers(new TxnId[blockCapacity]) {}
+    
+    int size() const { return publishedSize.load(std::memory_order_acquire); }
+};
+
+// Version history of one variable at one site, stored column-wise and sorted 
+// by commitTimestamp. Snapshot searches only touch the timestamp column; the 
+// writer column is cold and read only when a ReadInfo is recorded.
+//
+// One committer thread mutates a chain while any number of readers search 
+// it without locks: appends that fit are published in place, and anything 
+// that moves versions (growth, pruning, reload) builds a new block, swaps 
+// the pointer and retires the old block to the EpochDomain. Readers pin an 
+// EpochGuard only while they search a block and copy a version out of it.
+class VersionChain {
+private:
+    std::atomic<VersionBlock*> block;
+    
+    static constexpr int MIN_CAPACITY = 4;
+    
+    // Writer side: the block the committer itself last published
+    VersionBlock* current() const { return block.load(std::memory_order_relaxed); }
+    
+    void publish(VersionBlock* next) {
+        VersionBlock* previous = block.exchange(next, std::memory_order_acq_rel);
+        EpochDomain::global().retire(previous);
+    }
+    
+    // New block holding versions [first, end) of the current one
+    VersionBlock* copyFrom(int first, int capacity) const {
+        VersionBlock* source = current();
+        int count = source ? source->size() - first : 0;
+        auto* next = new VersionBlock(std::max(capacity, MIN_CAPACITY));
+        if (count > 0) {
+            std::copy_n(source->commitTimestamps.get() + first, count, next->commitTimestamps.get());
+            std::copy_n(source->values.get() + first, count, next->values.get());
+            std::copy_n(source->writers.get() + first, count, next->writers.get());
+        }
+        next->publishedSize.store(std::max(count, 0), std::memory_order_relaxed);
+        return next;
+    }
+    
+public:
+    VersionChain() : block(nullptr) {}
+    
+    // Owner teardown: no reader can still be inside this chain
+    ~VersionChain() { delete current(); }
+    
+    VersionChain(const VersionChain&) = delete;
+    VersionChain& operator=(const VersionChain&) = delete;
+    
+    // Reader side: the published block (null if the chain was never filled)
+    const VersionBlock* load() const { return block.load(std::memory_order_acquire); }
+    
+    void append(const Version& version) {
+        VersionBlock* target = current();
+        int count = target ? target->size() : 0;
+        if (!target || count == target->capacity) {
+            target = copyFrom(0, 2 * count);
+            target->commitTimestamps[count] = version.commitTimestamp;
+            target->values[count] = version.value;
+            target->writers[count] = version.writerTransactionId;
+            target->publishedSize.store(count + 1, std::memory_order_relaxed);
+            publish(target);
+            return;
+        }
+        target->commitTimestamps[count] = version.commitTimestamp;
+        target->values[count] = version.value;
+        target->writers[count] = version.writerTransactionId;
+        target->publishedSize.store(count + 1, std::memory_order_release);
+    }
+    
+    // Drop the oldest `count` versions. Readers may be inside them, so the 
+    // survivors move to a new block, sized down once the chain has shrunk 
+    // well below its capacity.
+    void eraseOldest(int count) {
+        VersionBlock* source = current();
+        int remaining = source->size() - count;
+        int capacity = source->capacity > 4 * remaining ? 2 * remaining : source->capacity;
+        publish(copyFrom(count, capacity));
+    }
+    
+    // Take over source's versions (leaving it empty), e.g. after a reload
+    void replaceWith(VersionChain& source) {
+        publish(source.block.exchange(nullptr, std::memory_order_relaxed));
+    }
+    
+    void clear() {
+        publish(nullptr);
+    }
+    
+    // Fill an unpublished chain in bulk: fill(timestamps, values, writers) 
+    // writes `count` versions and returns false on failure
+    template <typename Fill>
+    bool assignColumns(int count, Fill fill) {
+        auto* next = new VersionBlock(std::max(count, MIN_CAPACITY));
+        if (!fill(next->commitTimestamps.get(), next->values.get(), next->writers.get())) {
+            delete next;
+            return false;
+        }
+        next->publishedSize.store(count, std::memory_order_relaxed);
+        publish(next);
+        return true;
+    }
+    
+    int size() const {
+        EpochGuard guard;
+        const VersionBlock* published = load();
+        return published ? published->size() : 0;
+    }
+    bool empty() const { return size() == 0; }
+    int capacity() const {
+        EpochGuard guard;
+        const VersionBlock* published = load();
+        return published ? published->capacity : 0;
+    }
+    
+    // Bytes held per version across all columns
+    static constexpr int BYTES_PER_VERSION = 2 * sizeof(int) + sizeof(TxnId);
+};
+
+// One version as found in a VersionBlock, copied out while the finder held 
+// an EpochGuard. It owns no pointer into the chain, so it stays valid after 
+// the block is replaced or reclaimed. index is the version's position in the 
+// chain at lookup time (meaningful to the chain's committer only).
+class VersionView {
+private:
+    bool found;
+    int index;
+    int versionValue;
+    int versionCommitTimestamp;
+    TxnId writer;
+    
+public:
+    VersionView() 
+        : found(false), index(-1), versionValue(0), versionCommitTimestamp(0), 
+          writer(INITIAL_TXN_ID) {}
+    VersionView(const VersionBlock& block, int versionIndex) 
+        : found(true), index(versionIndex), versionValue(block.values[versionIndex]),
+          versionCommitTimestamp(block.commitTimestamps[versionIndex]), 
+          writer(block.writers[versionIndex]) {}
+    
+    explicit operator bool() const { return found; }
+    
+    int getIndex() const { return index; }
+    int value() const { return versionValue; }
+    int commitTimestamp() const { return versionCommitTimestamp; }
+    TxnId writerTransactionId() const { return writer; }
 };
 
 } 
 
-#endif 
\ No newline at end of file
+#endif
@@ -7,18 +7,18 @@
 #ifndef WAITINFO_H
 #define WAITINFO_H
 
-#include <set>
+#include "SiteSet.h"
 
 namespace RepCRec {
 
 class WaitInfo {
 public:
     int variableId;
-    std::set<int> candidateSites;  
+    SiteSet candidateSites;  
     
     WaitInfo() : variableId(-1) {}
     
-    WaitInfo(int varId, const std::set<int>& sites) 
+    WaitInfo(int varId, const SiteSet& sites) 
         : variableId(varId), candidateSites(sites) {}
     
     void clear() {
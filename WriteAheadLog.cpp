@@ -0,0 +1,255 @@
+// WriteAheadLog.cpp
+// Author: Aishwarya and Archita
+// Date: December 2025
+// Purpose: Implementation of the per-site write-ahead log
+
+#include "WriteAheadLog.h"
+#include "SnapshotFile.h"
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace RepCRec {
+
+namespace {
+
+// Record layout (native byte order):
+//   uint32 payloadBytes | uint32 checksum(payload) | payload
+// payload:
+//   int32 commitTimestamp | int32 writeCount | writeCount x (int32 var, int32 value)
+const size_t RECORD_HEADER_BYTES = 2 * sizeof(uint32_t);
+const size_t PAYLOAD_FIXED_BYTES = 2 * sizeof(int32_t);
+const size_t WRITE_ENTRY_BYTES = 2 * sizeof(int32_t);
+
+template <typename T>
+void put(std::vector<char>& buffer, size_t& offset, T value) {
+    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+    offset += sizeof(T);
+}
+
+template <typename T>
+T get(const char* data, size_t& offset) {
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    offset += sizeof(T);
+    return value;
+}
+
+// Appends one record for writes (a range of (variableId, value) pairs) to buffer
+template <typename Writes>
+void encodeRecord(std::vector<char>& buffer, int commitTimestamp, const Writes& writes,
+                  size_t writeCount) {
+    size_t start = buffer.size();
+    size_t payloadBytes = PAYLOAD_FIXED_BYTES + writeCount * WRITE_ENTRY_BYTES;
+    buffer.resize(start + RECORD_HEADER_BYTES + payloadBytes);
+
+    size_t offset = start + RECORD_HEADER_BYTES;
+    put<int32_t>(buffer, offset, commitTimestamp);
+    put<int32_t>(buffer, offset, static_cast<int32_t>(writeCount));
+    for (const auto& [variableId, value] : writes) {
+        put<int32_t>(buffer, offset, variableId);
+        put<int32_t>(buffer, offset, value);
+    }
+
+    size_t header = start;
+    put<uint32_t>(buffer, header, static_cast<uint32_t>(payloadBytes));
+    put<uint32_t>(buffer, header,
+                  checksumBytes(buffer.data() + start + RECORD_HEADER_BYTES, payloadBytes));
+}
+
+// Length of the longest prefix of data made of complete, intact records;
+// calls visit on each one when given
+size_t scanRecords(const std::vector<char>& data,
+                   const std::function<void(const LogRecord&)>* visit, int* recordCount) {
+    std::vector<std::pair<int, int>> writes;
+    size_t offset = 0;
+    int count = 0;
+
+    while (data.size() - offset >= RECORD_HEADER_BYTES) {
+        size_t cursor = offset;
+        uint32_t payloadBytes = get<uint32_t>(data.data(), cursor);
+        uint32_t expected = get<uint32_t>(data.data(), cursor);
+
+        if (payloadBytes < PAYLOAD_FIXED_BYTES || payloadBytes > data.size() - cursor ||
+            checksumBytes(data.data() + cursor, payloadBytes) != expected) {
+            break;
+        }
+
+        const char* payload = data.data() + cursor;
+        size_t field = 0;
+        LogRecord record;
+        record.commitTimestamp = get<int32_t>(payload, field);
+        record.writeCount = get<int32_t>(payload, field);
+
+        if (record.writeCount < 0 ||
+            PAYLOAD_FIXED_BYTES + record.writeCount * WRITE_ENTRY_BYTES != payloadBytes) {
+            break;
+        }
+
+        if (visit) {
+            writes.resize(record.writeCount);
+            for (auto& [variableId, value] : writes) {
+                variableId = get<int32_t>(payload, field);
+                value = get<int32_t>(payload, field);
+            }
+            record.writes = writes.data();
+            (*visit)(record);
+        }
+
+        offset = cursor + payloadBytes;
+        count++;
+    }
+
+    if (recordCount) {
+        *recordCount = count;
+    }
+    return offset;
+}
+
+}
+
+WriteAheadLog::WriteAheadLog(const WalConfig& config, int siteId)
+    : path(config.directory + "/site" + std::to_string(siteId) + ".wal"), fd(-1),
+      durability(config.durability),
+      groupCommitSize(config.groupCommitSize > 0 ? config.groupCommitSize : 1),
+      unsyncedCommits(0), appendedRecords(0), syncCount(0) {
+    if (::mkdir(config.directory.c_str(), 0755) != 0 && errno != EEXIST) {
+        throw std::runtime_error("Cannot create log directory " + config.directory +
+                                 ": " + std::strerror(errno));
+    }
+
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open log " + path + ": " + std::strerror(errno));
+    }
+
+    std::vector<char> contents = readFile();
+    size_t validBytes = scanRecords(contents, nullptr, nullptr);
+    if (validBytes < contents.size() && ::ftruncate(fd, validBytes) != 0) {
+        throw std::runtime_error("Cannot truncate log " + path + ": " + std::strerror(errno));
+    }
+}
+
+WriteAheadLog::~WriteAheadLog() {
+    if (fd >= 0) {
+        // Destructors must not throw; a failed final fsync is reported nowhere
+        if (unsyncedCommits > 0 && durability != DurabilityLevel::ASYNC) {
+            ::fdatasync(fd);
+        }
+        ::close(fd);
+    }
+}
+
+std::vector<char> WriteAheadLog::readFile() const {
+    std::vector<char> contents;
+    int readFd = ::open(path.c_str(), O_RDONLY);
+    if (readFd < 0) {
+        return contents;
+    }
+
+    struct stat info;
+    if (::fstat(readFd, &info) == 0 && info.st_size > 0) {
+        contents.resize(static_cast<size_t>(info.st_size));
+        size_t total = 0;
+        while (total < contents.size()) {
+            ssize_t n = ::read(readFd, contents.data() + total, contents.size() - total);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                break;
+            }
+            total += static_cast<size_t>(n);
+        }
+        contents.resize(total);
+    }
+
+    ::close(readFd);
+    return contents;
+}
+
+void WriteAheadLog::writeAll(const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t n = ::write(fd, data, length);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0) {
+            throw std::runtime_error("Cannot append to log " + path + ": " + std::strerror(errno));
+        }
+        data += n;
+        length -= static_cast<size_t>(n);
+    }
+}
+
+void WriteAheadLog::appendCommit(int commitTimestamp, const FlatMap<int, int>& writes) {
+    encodeBuffer.clear();
+    encodeRecord(encodeBuffer, commitTimestamp, writes, writes.size());
+
+    writeAll(encodeBuffer.data(), encodeBuffer.size());
+    appendedRecords++;
+    unsyncedCommits++;
+
+    if (durability == DurabilityLevel::SYNC ||
+        (durability == DurabilityLevel::GROUP && unsyncedCommits >= groupCommitSize)) {
+        sync();
+    }
+}
+
+void WriteAheadLog::appendCopiedVersions(int variableId, const std::vector<Version>& versions) {
+    if (versions.empty()) {
+        return;
+    }
+
+    encodeBuffer.clear();
+    for (const Version& version : versions) {
+        std::array<std::pair<int, int>, 1> write = {{ { variableId, version.value } }};
+        encodeRecord(encodeBuffer, version.commitTimestamp, write, write.size());
+    }
+
+    writeAll(encodeBuffer.data(), encodeBuffer.size());
+    appendedRecords += static_cast<long long>(versions.size());
+    unsyncedCommits++;
+    sync();
+}
+
+void WriteAheadLog::sync() {
+    if (unsyncedCommits == 0 || durability == DurabilityLevel::ASYNC) {
+        return;
+    }
+
+    if (::fdatasync(fd) != 0) {
+        throw std::runtime_error("Cannot sync log " + path + ": " + std::strerror(errno));
+    }
+    unsyncedCommits = 0;
+    syncCount++;
+}
+
+void WriteAheadLog::truncate() {
+    if (::ftruncate(fd, 0) != 0) {
+        throw std::runtime_error("Cannot truncate log " + path + ": " + std::strerror(errno));
+    }
+    if (durability != DurabilityLevel::ASYNC && ::fdatasync(fd) != 0) {
+        throw std::runtime_error("Cannot sync log " + path + ": " + std::strerror(errno));
+    }
+    unsyncedCommits = 0;
+}
+
+long long WriteAheadLog::getSizeBytes() const {
+    struct stat info;
+    return ::fstat(fd, &info) == 0 ? static_cast<long long>(info.st_size) : 0;
+}
+
+int WriteAheadLog::replay(const std::function<void(const LogRecord&)>& visit) const {
+    std::vector<char> contents = readFile();
+    int count = 0;
+    scanRecords(contents, &visit, &count);
+    return count;
+}
+
+}
@@ -0,0 +1,175 @@
+// WriteAheadLog.h
+// Author: Aishwarya and Archita
+// Date: December 2025
+// Purpose: Per-site append-only log of committed writes, replayed on startup
+//          and recovery
+// Side effects: Creates, appends to and fsyncs files under WalConfig::directory
+
+#ifndef WRITEAHEADLOG_H
+#define WRITEAHEADLOG_H
+
+#include "Constants.h"
+#include "FlatMap.h"
+#include "TransactionIdTable.h"
+#include "Version.h"
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace RepCRec {
+
+// One decoded commit record; writes points into the replay buffer. No 
+// writer is stored: a TxnId means nothing to the next process (versions 
+// replayed from the log get RECOVERED_TXN_ID).
+struct LogRecord {
+    int commitTimestamp;
+    int writeCount;
+    const std::pair<int, int>* writes;  // (variableId, value)
+};
+
+class WriteAheadLog {
+private:
+    std::string path;
+    int fd;
+    DurabilityLevel durability;
+    int groupCommitSize;
+    int unsyncedCommits;
+
+    // Reused encoding buffer so appends do not allocate in steady state
+    std::vector<char> encodeBuffer;
+
+    // Statistics
+    long long appendedRecords;
+    long long syncCount;
+
+    // Whole log file contents (empty if the file does not exist)
+    std::vector<char> readFile() const;
+
+    void writeAll(const char* data, size_t length);
+
+public:
+    /**
+     * WriteAheadLog Constructor
+     * Author: Archita Arora
+     * Input:
+     *   - config (WalConfig): Directory, durability level and group size
+     *   - siteId (int): Site whose log this is (file site<siteId>.wal)
+     * Output: None (constructor)
+     * Description: Creates the log directory if needed and opens the site's
+     *              log for appending. A torn or corrupt tail left by a crash
+     *              mid-append is truncated so new records follow the last
+     *              valid one.
+     * Side Effects:
+     *   - Creates the directory and the log file if missing
+     *   - May truncate the log file
+     *   - Throws std::runtime_error if the log cannot be opened
+     */
+    WriteAheadLog(const WalConfig& config, int siteId);
+
+    /**
+     * WriteAheadLog Destructor
+     * Author: Aishwarya Anand
+     * Description: Flushes any commits still waiting for a group fsync and
+     *              closes the file.
+     */
+    ~WriteAheadLog();
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    /**
+     * appendCommit - Log one transaction's writes at this site
+     * Author: Aishwarya Anand
+     * Input:
+     *   - commitTimestamp (int): Commit time of the new versions (which 
+     *                            also identifies the committing transaction)
+     *   - writes (FlatMap<int,int>): variableId -> value buffered at this site
+     * Output: None
+     * Description: Encodes a checksummed record and hands it to the OS in a
+     *              single write(). Under SYNC the record is fsync'd before
+     *              returning; under GROUP one fsync covers groupCommitSize
+     *              commits, and the TransactionManager reports none of them
+     *              until it has synced every site (see sync()), so an OS crash
+     *              loses only unreported commits. A site failure in the
+     *              simulator never loses them, since the OS already holds
+     *              every record.
+     * Side Effects:
+     *   - Appends to the log file; may fsync
+     *   - Throws std::runtime_error if the write fails
+     */
+    void appendCommit(int commitTimestamp, const FlatMap<int, int>& writes);
+
+    /**
+     * appendCopiedVersions - Log versions fetched from a peer during catch-up
+     * Author: Archita Arora
+     * Input:
+     *   - variableId (int): Variable the versions belong to
+     *   - versions (vector<Version>): Committed versions, oldest first
+     * Output: None
+     * Description: Writes one single-write record per version (keeping its 
+     *              original commit time) in a single write(), then 
+     *              syncs unless durability is ASYNC, so the copies are as 
+     *              durable as a commit before the variable's gate reopens.
+     * Side Effects:
+     *   - Appends to the log file; may fsync
+     *   - Throws std::runtime_error if the write fails
+     */
+    void appendCopiedVersions(int variableId, const std::vector<Version>& versions);
+
+    /**
+     * sync - Force every appended record to stable storage
+     * Author: Archita Arora
+     * Input: None
+     * Output: None
+     * Description: Closes the current commit group early. No-op when nothing
+     *              is pending.
+     * Side Effects: fsyncs the log file
+     */
+    void sync();
+
+    /**
+     * truncate - Drop every record once a checkpoint covers them
+     * Author: Aishwarya Anand
+     * Input: None
+     * Output: None
+     * Description: Called only after the site's checkpoint file is durable. 
+     *              If a crash lands between the two, replay skips records at 
+     *              or before the checkpoint's timestamp, so nothing is applied 
+     *              twice.
+     * Side Effects: Empties the log file (fsync'd unless durability is ASYNC)
+     */
+    void truncate();
+
+    // Current size of the log file in bytes
+    long long getSizeBytes() const;
+
+    /**
+     * replay - Visit every valid record in log order
+     * Author: Aishwarya Anand
+     * Input:
+     *   - visit (function): Called once per commit record
+     * Output: int - Number of records replayed
+     * Description: Reads the whole file with one read pass and decodes it in
+     *              place; stops at the first record whose length or checksum
+     *              does not match.
+     * Side Effects: None (read-only operation)
+     */
+    int replay(const std::function<void(const LogRecord&)>& visit) const;
+
+    long long getAppendedRecords() const {
+        return appendedRecords;
+    }
+
+    long long getSyncCount() const {
+        return syncCount;
+    }
+
+    const std::string& getPath() const {
+        return path;
+    }
+};
+
+}
+
+#endif
@@ -7,14 +7,14 @@
 #ifndef WRITEINFO_H
 #define WRITEINFO_H
 
-#include <set>
+#include "SiteSet.h"
 
 namespace RepCRec {
 
 class WriteInfo {
 public:
     int value;
-    std::set<int> sitesApplied;  
+    SiteSet sitesApplied;  
     
     WriteInfo(int val) : value(val) {}
     
@@ -0,0 +1,718 @@
+// bench.cpp
+// Author: Aishwarya and Archita
+// Date: December 2025
+// Purpose: Microbenchmarks for the hot paths of the RepCRec engine
+// Usage: make bench && ./repcrec_bench
+// Side effects: Replaces global operator new/delete to count heap allocations
+
+#include "CommandProtocol.h"
+#include "DataManager.h"
+#include "Parser.h"
+#include "TransactionManager.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <thread>
+#include <stdlib.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ============================================================================
+// ALLOCATION COUNTING
+// ============================================================================
+
+// Atomic because site worker threads allocate too
+static std::atomic<long long> g_allocationCount{0};
+
+void* operator new(std::size_t size) {
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchResult {
+    double nsPerOp;
+    double allocsPerOp;
+};
+
+// Runs body() `iterations` times and reports time and allocations per call
+template <typename Body>
+BenchResult measure(long long iterations, Body body) {
+    long long allocsBefore = g_allocationCount;
+    auto start = Clock::now();
+    for (long long i = 0; i < iterations; i++) {
+        body(i);
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return { elapsed / iterations,
+             static_cast<double>(g_allocationCount - allocsBefore) / iterations };
+}
+
+void report(const char* name, const BenchResult& r) {
+    std::printf("  %-40s %10.1f ns/op %8.2f allocs/op\n", name, r.nsPerOp, r.allocsPerOp);
+}
+
+// Prevents the optimizer from discarding benchmark results
+volatile long long g_sink = 0;
+
+// ============================================================================
+// SNAPSHOT READS
+// ============================================================================
+
+// Builds a site whose replicated variables carry `chainLength` versions each
+void populateChains(RepCRec::DataManager& dm, int chainLength) {
+    for (int t = 1; t <= chainLength; t++) {
+        RepCRec::TxnId txnId = t;
+        for (int varId = 2; varId <= RepCRec::getNumVariables(); varId += 2) {
+            dm.writeVariable(varId, t, txnId);
+        }
+        dm.commitWrites(txnId, t * 2);
+    }
+}
+
+void benchSnapshotReads() {
+    const int chainLength = 4096;
+    const long long iterations = 2000000;
+
+    RepCRec::DataManager dm(1);
+    populateChains(dm, chainLength);
+
+    std::printf("Snapshot reads (%d versions per variable)\n", chainLength);
+
+    // Previous read path: copy the visible version into a fresh shared_ptr
+    report("readVariable + make_shared copy (old)", measure(iterations, [&](long long i) {
+        int varId = 2 + 2 * static_cast<int>(i % (RepCRec::getNumVariables() / 2));
+        RepCRec::VersionView v = dm.readVariable(varId, static_cast<int>(i % (chainLength * 2)));
+        auto copy = std::make_shared<RepCRec::Version>(v.value(), v.commitTimestamp(),
+                                                       v.writerTransactionId());
+        g_sink += copy->value;
+    }));
+
+    report("readVariable (copy under EpochGuard)", measure(iterations, [&](long long i) {
+        int varId = 2 + 2 * static_cast<int>(i % (RepCRec::getNumVariables() / 2));
+        RepCRec::VersionView v = dm.readVariable(varId, static_cast<int>(i % (chainLength * 2)));
+        g_sink += v.value() + v.commitTimestamp();
+    }));
+}
+
+// ============================================================================
+// CONCURRENT SNAPSHOT READS
+// ============================================================================
+
+void benchConcurrentReads() {
+    const int chainLength = 1024;
+    const auto duration = std::chrono::milliseconds(200);
+    const int maxReaders = std::max(1u, std::min(8u, std::thread::hardware_concurrency()));
+
+    std::printf("Concurrent snapshot reads (one committer appending and pruning)\n");
+
+    for (int readers = 1; readers <= maxReaders; readers *= 2) {
+        RepCRec::DataManager dm(1);
+        populateChains(dm, chainLength);
+
+        std::atomic<int> latestCommit{chainLength * 2};
+        std::atomic<bool> stop{false};
+        std::atomic<long long> totalReads{0};
+        long long commits = 0;
+
+        std::thread committer([&] {
+            for (int t = chainLength + 1; !stop.load(std::memory_order_relaxed); t++) {
+                int varId = 2 + 2 * (t % (RepCRec::getNumVariables() / 2));
+                dm.writeVariable(varId, t, t);
+                dm.commitWrites(t, t * 2);
+                latestCommit.store(t * 2, std::memory_order_release);
+                if (t % 256 == 0) {
+                    dm.collectGarbage(t * 2 - chainLength);
+                }
+                commits++;
+            }
+        });
+
+        std::vector<std::thread> threads;
+        for (int r = 0; r < readers; r++) {
+            threads.emplace_back([&, r] {
+                long long reads = 0, sum = 0;
+                auto end = Clock::now() + duration;
+                while (Clock::now() < end) {
+                    for (int i = 0; i < 1024; i++, reads++) {
+                        int varId = 2 + 2 * ((i + r) % (RepCRec::getNumVariables() / 2));
+                        int snapshot = latestCommit.load(std::memory_order_acquire) - (i % 512);
+                        if (RepCRec::VersionView v = dm.readVariable(varId, snapshot)) {
+                            sum += v.value();
+                        }
+                    }
+                }
+                g_sink += sum;
+                totalReads += reads;
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        stop = true;
+        committer.join();
+
+        double seconds = std::chrono::duration<double>(duration).count();
+        std::printf("  %d reader thread(s)%-23s %10.2f M reads/s %8.2f M commits/s\n", readers, "",
+                    totalReads / seconds / 1e6, commits / seconds / 1e6);
+    }
+}
+
+// ============================================================================
+// TRANSACTION THROUGHPUT
+// ============================================================================
+
+// Accumulates time and allocations over many short measured sections
+struct PhaseTimer {
+    double totalNs = 0;
+    long long allocs = 0;
+    long long ops = 0;
+
+    template <typename Body>
+    void run(int opsInSection, Body body) {
+        long long allocsBefore = g_allocationCount;
+        auto start = Clock::now();
+        body();
+        totalNs += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        allocs += g_allocationCount - allocsBefore;
+        ops += opsInSection;
+    }
+
+    BenchResult result() const {
+        return { totalNs / ops, static_cast<double>(allocs) / ops };
+    }
+};
+
+void benchTransactionThroughput() {
+    const int batches = 20000;
+    const int batchSize = 8;
+
+    // TransactionManager reports every operation on stdout; discard it
+    std::ostringstream sink;
+    std::streambuf* original = std::cout.rdbuf(sink.rdbuf());
+
+    RepCRec::TransactionManager tm;
+    std::vector<std::string> names;
+    for (int i = 0; i < batchSize; i++) {
+        names.push_back("T" + std::to_string(i + 1));
+    }
+
+    PhaseTimer beginTimer, readTimer, writeTimer, endTimer;
+    for (int b = 0; b < batches; b++) {
+        beginTimer.run(batchSize, [&] {
+            for (int i = 0; i < batchSize; i++) tm.begin(names[i]);
+        });
+        readTimer.run(2 * batchSize, [&] {
+            for (int i = 0; i < batchSize; i++) {
+                tm.read(names[i], 1 + (b + i) % RepCRec::getNumVariables());
+                tm.read(names[i], 1 + (b + 2 * i + 7) % RepCRec::getNumVariables());
+            }
+        });
+        writeTimer.run(batchSize, [&] {
+            for (int i = 0; i < batchSize; i++) {
+                tm.write(names[i], 1 + (b * batchSize + i) % RepCRec::getNumVariables(), b);
+            }
+        });
+        endTimer.run(batchSize, [&] {
+            for (int i = 0; i < batchSize; i++) tm.end(names[i]);
+        });
+        sink.str("");
+    }
+
+    std::cout.rdbuf(original);
+
+    std::printf("Transaction throughput (%d batches of %d concurrent transactions)\n",
+                batches, batchSize);
+    report("begin", beginTimer.result());
+    report("read", readTimer.result());
+    report("write", writeTimer.result());
+    report("end", endTimer.result());
+}
+
+// ============================================================================
+// EVENT OUTPUT
+// ============================================================================
+
+// Accepts and discards characters, so text sinks pay for formatting but not I/O
+class DiscardBuffer : public std::streambuf {
+private:
+    char buffer[4096];
+
+protected:
+    int_type overflow(int_type ch) override {
+        setp(buffer, buffer + sizeof(buffer));
+        return traits_type::not_eof(ch);
+    }
+};
+
+void benchEventOutput() {
+    struct SinkConfig {
+        const char* name;
+        RepCRec::OutputFormat format;
+        bool background;
+    };
+    const SinkConfig configs[] = {
+        { "text, inline", RepCRec::OutputFormat::TEXT, false },
+        { "text, background thread", RepCRec::OutputFormat::TEXT, true },
+        { "jsonl, inline", RepCRec::OutputFormat::JSON_LINES, false },
+        { "none", RepCRec::OutputFormat::NONE, false },
+    };
+    const int transactions = 50000;
+    const int opsPerTransaction = 5;  // begin, 2 reads, write, end
+
+    std::printf("Event output (%d transactions x %d operations; per operation)\n",
+                transactions, opsPerTransaction);
+
+    DiscardBuffer discardBuffer;
+    std::ostream discard(&discardBuffer);
+
+    for (const SinkConfig& config : configs) {
+        RepCRec::TransactionManager tm;
+        tm.setEventSink(RepCRec::makeEventSink(config.format, discard, config.background));
+
+        BenchResult result = measure(1, [&](long long) {
+            for (int t = 0; t < transactions; t++) {
+                std::string name = "T" + std::to_string(t % 16);
+                int var = 1 + t % RepCRec::getNumVariables();
+                tm.begin(name);
+                tm.read(name, var);
+                tm.read(name, 1 + (var * 7) % RepCRec::getNumVariables());
+                tm.write(name, var, t);
+                tm.end(name);
+            }
+            tm.flushEvents();
+        });
+        const double ops = static_cast<double>(transactions) * opsPerTransaction;
+        report(config.name, { result.nsPerOp / ops, result.allocsPerOp / ops });
+    }
+}
+
+// ============================================================================
+// REPLICA READ BALANCE
+// ============================================================================
+
+void benchReplicaBalance() {
+    struct Policy {
+        const char* name;
+        RepCRec::ReplicaSelection selection;
+    };
+    const Policy policies[] = {
+        { "lowest", RepCRec::ReplicaSelection::LOWEST_SITE },
+        { "round-robin", RepCRec::ReplicaSelection::ROUND_ROBIN },
+        { "least-loaded", RepCRec::ReplicaSelection::LEAST_OUTSTANDING },
+        { "affinity", RepCRec::ReplicaSelection::AFFINITY },
+    };
+    const int transactions = 5000;
+    const int readsPerTransaction = 4;
+
+    std::printf("Replica read balance (%d transactions x %d replicated reads)\n",
+                transactions, readsPerTransaction);
+
+    std::ostringstream sink;
+    std::streambuf* original = std::cout.rdbuf(sink.rdbuf());
+
+    for (const Policy& policy : policies) {
+        RepCRec::TransactionManager tm(RepCRec::ValidationMode::STRICT_GRAPH,
+                                       RepCRec::WalConfig(), RepCRec::RecoveryMode::READ_GATE,
+                                       policy.selection);
+        for (int t = 0; t < transactions; t++) {
+            std::string name = "T" + std::to_string(t % 64);
+            tm.begin(name);
+            for (int r = 0; r < readsPerTransaction; r++) {
+                tm.read(name, 2 + 2 * ((t + r) % (RepCRec::getNumVariables() / 2)));
+            }
+            tm.end(name);
+            sink.str("");
+        }
+
+        const auto& reads = tm.getReadsServedBySite();
+        long long most = 0, least = reads[1];
+        for (int siteId = 1; siteId <= RepCRec::getNumSites(); siteId++) {
+            most = std::max(most, reads[siteId]);
+            least = std::min(least, reads[siteId]);
+        }
+        std::cout.rdbuf(original);
+        std::printf("  %-40s busiest site %6lld reads, idlest %6lld\n", policy.name, most, least);
+        std::cout.rdbuf(sink.rdbuf());
+    }
+
+    std::cout.rdbuf(original);
+}
+
+// ============================================================================
+// DURABLE COMMITS
+// ============================================================================
+
+void benchDurableCommits() {
+    char dirTemplate[] = "/tmp/repcrec_bench_walXXXXXX";
+    if (!mkdtemp(dirTemplate)) {
+        std::printf("Durable commits: cannot create a temporary directory\n");
+        return;
+    }
+
+    struct Level {
+        const char* name;
+        RepCRec::DurabilityLevel durability;
+        long long iterations;
+    };
+    const Level levels[] = {
+        { "commitWrites, durability off", RepCRec::DurabilityLevel::OFF, 200000 },
+        { "commitWrites, durability async", RepCRec::DurabilityLevel::ASYNC, 200000 },
+        { "commitWrites, durability group (8)", RepCRec::DurabilityLevel::GROUP, 20000 },
+        { "commitWrites, durability sync", RepCRec::DurabilityLevel::SYNC, 2000 },
+    };
+
+    std::printf("Durable commits (one write per commit, log in %s)\n", dirTemplate);
+
+    for (const Level& level : levels) {
+        RepCRec::WalConfig config;
+        config.durability = level.durability;
+        config.directory = std::string(dirTemplate) + "/" + std::to_string(
+            static_cast<int>(level.durability));
+        config.groupCommitSize = 8;
+
+        RepCRec::DataManager dm(1, config);
+        report(level.name, measure(level.iterations, [&](long long i) {
+            RepCRec::TxnId txnId = static_cast<RepCRec::TxnId>(i + 1);
+            dm.writeVariable(2, static_cast<int>(i), txnId);
+            dm.commitWrites(txnId, static_cast<int>(i + 1));
+        }));
+    }
+
+    std::string cleanup = std::string("rm -rf ") + dirTemplate;
+    if (std::system(cleanup.c_str()) != 0) {
+        std::printf("  (could not remove %s)\n", dirTemplate);
+    }
+}
+
+// ============================================================================
+// RESTART TIME
+// ============================================================================
+
+void benchRestart() {
+    char dirTemplate[] = "/tmp/repcrec_bench_ckptXXXXXX";
+    if (!mkdtemp(dirTemplate)) {
+        std::printf("Restart time: cannot create a temporary directory\n");
+        return;
+    }
+
+    std::printf("Restart time vs log size (site 1, one write per commit)\n");
+    std::printf("  %-12s %-14s %12s %14s %12s\n",
+                "commits", "checkpointed", "log bytes", "records read", "restart us");
+
+    for (int commits : { 1000, 10000, 100000 }) {
+        for (bool checkpointed : { false, true }) {
+            RepCRec::WalConfig config;
+            config.durability = RepCRec::DurabilityLevel::ASYNC;
+            config.directory = std::string(dirTemplate) + "/" + std::to_string(commits) +
+                               (checkpointed ? "c" : "");
+            {
+                RepCRec::DataManager dm(1, config);
+                for (int t = 1; t <= commits; t++) {
+                    dm.writeVariable(2 + 2 * (t % 10), t, t);
+                    dm.commitWrites(t, t);
+                }
+                if (checkpointed) {
+                    dm.collectGarbage(commits);
+                    dm.checkpoint();
+                }
+            }
+
+            RepCRec::DataManager restarted(1, config);
+            std::printf("  %-12d %-14s %12lld %14lld %12.1f\n", commits,
+                        checkpointed ? "yes" : "no", restarted.getLogSizeBytes(),
+                        restarted.getLastReplayedRecords(), restarted.getLastLoadMicros());
+        }
+    }
+
+    std::string cleanup = std::string("rm -rf ") + dirTemplate;
+    if (std::system(cleanup.c_str()) != 0) {
+        std::printf("  (could not remove %s)\n", dirTemplate);
+    }
+}
+
+// ============================================================================
+// COMMIT LATENCY VS REPLICATED WRITES
+// ============================================================================
+
+void benchReplicatedCommits() {
+    char dirTemplate[] = "/tmp/repcrec_bench_threadsXXXXXX";
+    if (!mkdtemp(dirTemplate)) {
+        std::printf("Replicated commits: cannot create a temporary directory\n");
+        return;
+    }
+
+    struct Mode {
+        const char* name;
+        RepCRec::ExecutionMode execution;
+        RepCRec::DurabilityLevel durability;
+        long long transactions;
+    };
+    const Mode modes[] = {
+        { "deterministic, durability off", RepCRec::ExecutionMode::DETERMINISTIC,
+          RepCRec::DurabilityLevel::OFF, 20000 },
+        { "site threads, durability off", RepCRec::ExecutionMode::SITE_THREADS,
+          RepCRec::DurabilityLevel::OFF, 20000 },
+        { "deterministic, durability sync", RepCRec::ExecutionMode::DETERMINISTIC,
+          RepCRec::DurabilityLevel::SYNC, 300 },
+        { "site threads, durability sync", RepCRec::ExecutionMode::SITE_THREADS,
+          RepCRec::DurabilityLevel::SYNC, 300 },
+    };
+    const int writeCounts[] = { 1, 2, 5, 10 };
+
+    std::printf("Commit latency vs replicated variables written (end() only, every "
+                "write reaches all %d sites)\n", RepCRec::getNumSites());
+    std::printf("  %-32s", "");
+    for (int writes : writeCounts) {
+        std::printf(" %9d var%s", writes, writes == 1 ? " " : "s");
+    }
+    std::printf("\n");
+
+    std::ostringstream sink;
+    std::streambuf* original = std::cout.rdbuf(sink.rdbuf());
+
+    for (const Mode& mode : modes) {
+        std::cout.rdbuf(original);
+        std::printf("  %-32s", mode.name);
+        std::cout.rdbuf(sink.rdbuf());
+
+        for (int writes : writeCounts) {
+            RepCRec::WalConfig config;
+            config.durability = mode.durability;
+            config.directory = std::string(dirTemplate) + "/" + std::to_string(
+                static_cast<int>(mode.execution)) + "_" + 
+                std::to_string(static_cast<int>(mode.durability)) + "_" + std::to_string(writes);
+            config.checkpointInterval = 0;
+
+            RepCRec::TransactionManager tm(RepCRec::ValidationMode::STRICT_GRAPH, config,
+                                           RepCRec::RecoveryMode::READ_GATE,
+                                           RepCRec::ReplicaSelection::LOWEST_SITE, mode.execution);
+            PhaseTimer endTimer;
+            for (long long t = 0; t < mode.transactions; t++) {
+                tm.begin("T1");
+                for (int w = 0; w < writes; w++) {
+                    tm.write("T1", 2 + 2 * w, static_cast<int>(t));
+                }
+                endTimer.run(1, [&] { tm.end("T1"); });
+                sink.str("");
+            }
+
+            std::cout.rdbuf(original);
+            std::printf(" %10.1f us", endTimer.result().nsPerOp / 1000);
+            std::cout.rdbuf(sink.rdbuf());
+        }
+
+        std::cout.rdbuf(original);
+        std::printf("\n");
+        std::cout.rdbuf(sink.rdbuf());
+    }
+
+    std::cout.rdbuf(original);
+
+    std::string cleanup = std::string("rm -rf ") + dirTemplate;
+    if (std::system(cleanup.c_str()) != 0) {
+        std::printf("  (could not remove %s)\n", dirTemplate);
+    }
+}
+
+// ============================================================================
+// COMMAND INGEST
+// ============================================================================
+
+// The text parser as it was before the string_view tokenizer: trim/split into
+// temporary strings, substr + stoi, and an if/else chain on the name. Kept
+// here only as the baseline for benchCommandIngest.
+std::string legacyTrim(const std::string& str) {
+    size_t first = str.find_first_not_of(" \t\n\r");
+    if (first == std::string::npos)
+        return "";
+    size_t last = str.find_last_not_of(" \t\n\r");
+    return str.substr(first, (last - first + 1));
+}
+
+bool legacyParseLine(const std::string& line, int& target, int& value, std::string& txn) {
+    std::string trimmedLine = legacyTrim(line);
+    if (trimmedLine.empty() || trimmedLine[0] == '/' || trimmedLine[0] == '#') {
+        return false;
+    }
+    size_t openParen = trimmedLine.find('(');
+    size_t closeParen = trimmedLine.find(')');
+    if (openParen == std::string::npos) {
+        return false;
+    }
+    std::string name = legacyTrim(trimmedLine.substr(0, openParen));
+    std::string argsStr;
+    if (closeParen != std::string::npos) {
+        argsStr = trimmedLine.substr(openParen + 1, closeParen - openParen - 1);
+    }
+    std::vector<std::string> args;
+    std::stringstream ss(argsStr);
+    std::string token;
+    while (std::getline(ss, token, ',')) {
+        args.push_back(legacyTrim(token));
+    }
+    auto variable = [](const std::string& v) {
+        return v[0] == 'x' ? std::stoi(v.substr(1)) : std::stoi(v);
+    };
+
+    target = value = 0;
+    if ((name == "begin" || name == "end") && args.size() == 1) {
+        txn = args[0];
+    } else if (name == "R" && args.size() == 2) {
+        txn = args[0];
+        target = variable(args[1]);
+    } else if (name == "W" && args.size() == 3) {
+        txn = args[0];
+        value = std::stoi(args[2]);
+        target = variable(args[1]);
+    } else if ((name == "fail" || name == "recover") && args.size() == 1) {
+        target = std::stoi(args[0]);
+    } else if (name != "dump") {
+        return false;
+    }
+    return true;
+}
+
+// Calls body(line) for every line of text, without copying
+template <typename Body>
+void forEachLine(const std::string& text, Body body) {
+    std::string_view rest(text);
+    while (!rest.empty()) {
+        size_t newline = rest.find('\n');
+        size_t length = newline == std::string_view::npos ? rest.size() : newline;
+        body(rest.substr(0, length));
+        rest.remove_prefix(newline == std::string_view::npos ? rest.size() : newline + 1);
+    }
+}
+
+void benchCommandIngest() {
+    const long long targetLines = 2000000;
+
+    // The checked-in scenarios (tests/*.txt and test_suite.txt), repeated
+    // until the corpus reaches a few million lines
+    std::vector<std::string> files;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator("tests", ec)) {
+        if (entry.path().extension() == ".txt") {
+            files.push_back(entry.path().string());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    files.push_back("test_suite.txt");
+
+    std::string scenarios;
+    for (const std::string& file : files) {
+        std::ifstream in(file);
+        std::ostringstream contents;
+        contents << in.rdbuf();
+        scenarios += contents.str();
+        if (!scenarios.empty() && scenarios.back() != '\n') {
+            scenarios += '\n';
+        }
+    }
+    long long scenarioLines = std::count(scenarios.begin(), scenarios.end(), '\n');
+    if (scenarioLines == 0) {
+        std::printf("Command ingest: skipped (run from the repository root to find tests/)\n");
+        return;
+    }
+
+    std::string text;
+    long long lines = 0;
+    while (lines < targetLines) {
+        text += scenarios;
+        lines += scenarioLines;
+    }
+
+    long long commands = 0;
+    std::string error;
+    RepCRec::ScriptCommand parsed;
+    forEachLine(text, [&](std::string_view line) {
+        commands += RepCRec::Parser::parseLine(line, parsed, error) ? 1 : 0;
+    });
+
+    std::istringstream textIn(text);
+    RepCRec::BinaryScriptWriter writer;
+    std::ostringstream diagnostics;
+    RepCRec::Parser::convertToBinary(textIn, writer, diagnostics);
+    const std::vector<char>& binary = writer.getBytes();
+
+    std::printf("Command ingest (tests/ corpus x%lld: %lld lines, %lld commands; "
+                "text %.1f MB, binary %.1f MB; decode only, per command)\n",
+                lines / scenarioLines, lines, commands, text.size() / 1e6, binary.size() / 1e6);
+
+    BenchResult legacyResult = measure(1, [&](long long) {
+        std::string line, txn;
+        int target = 0, value = 0;
+        long long sum = 0;
+        forEachLine(text, [&](std::string_view view) {
+            line.assign(view);
+            if (legacyParseLine(line, target, value, txn)) {
+                sum += target + value;
+            }
+        });
+        g_sink += sum;
+    });
+    report("text split/stoi (old)", { legacyResult.nsPerOp / commands, legacyResult.allocsPerOp / commands });
+
+    BenchResult textResult = measure(1, [&](long long) {
+        RepCRec::ScriptCommand command;
+        std::string lineError;
+        long long sum = 0;
+        forEachLine(text, [&](std::string_view line) {
+            if (RepCRec::Parser::parseLine(line, command, lineError)) {
+                sum += command.target + command.value + static_cast<long long>(command.transactionName.size());
+            }
+        });
+        g_sink += sum;
+    });
+    report("text string_view tokenizer", { textResult.nsPerOp / commands, textResult.allocsPerOp / commands });
+
+    BenchResult binaryResult = measure(1, [&](long long) {
+        RepCRec::BinaryScriptReader reader(binary.data(), binary.size());
+        RepCRec::CommandView command;
+        long long sum = 0;
+        while (reader.next(command)) {
+            sum += command.target + command.value;
+        }
+        g_sink += sum;
+    });
+    report("binary decode", { binaryResult.nsPerOp / commands, binaryResult.allocsPerOp / commands });
+}
+
+} // namespace
+
+int main() {
+    benchSnapshotReads();
+    benchConcurrentReads();
+    benchTransactionThroughput();
+    benchEventOutput();
+    benchReplicaBalance();
+    benchDurableCommits();
+    benchRestart();
+    benchReplicatedCommits();
+    benchCommandIngest();
+    return 0;
+}
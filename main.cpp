@@ -5,21 +5,224 @@
 
 #include "TransactionManager.h"
 #include "Parser.h"
+#include "ScriptFile.h"
+#include <cstdio>
 #include <iostream>
 #include <memory>
+#include <string>
+#include <vector>
+#include <unistd.h>
 
-int main() {
-    std::cout << "RepCRec - Distributed Database with SSI and Available Copies" << std::endl;
-    std::cout << "=============================================================" << std::endl << std::endl;
+// Usage: ./repcrec [--validation=strict|flags] [--variables=N] [--sites=N]
+//                  [--replication=N] [--durability=off|async|group|sync]
+//                  [--wal-dir=PATH] [--group-commit=N] [--checkpoint-every=N]
+//                  [--recovery=gated|catchup]
+//                  [--replica-policy=lowest|round-robin|least-loaded|affinity]
+//                  [--read-stats] [--site-threads]
+//                  [--input=text|binary] [--buffered-output]
+//                  [--output=text|jsonl|none] [--inline-output]
+//                  [--script=PATH | < script]
+//        ./repcrec --emit-binary < script.txt > script.bin
+
+namespace {
+
+// Whole stream in one buffer, for decoding binary scripts in place
+std::vector<char> readAll(std::FILE* stream) {
+    std::vector<char> contents;
+    size_t total = 0;
+    while (true) {
+        contents.resize(total + (1 << 20));
+        size_t n = std::fread(contents.data() + total, 1, contents.size() - total, stream);
+        total += n;
+        if (n == 0) {
+            break;
+        }
+    }
+    contents.resize(total);
+    return contents;
+}
+
+}
+int main(int argc, char* argv[]) {
+    RepCRec::ValidationMode mode = RepCRec::ValidationMode::STRICT_GRAPH;
+    RepCRec::CatalogConfig catalog;
+    RepCRec::WalConfig wal;
+    RepCRec::RecoveryMode recovery = RepCRec::RecoveryMode::READ_GATE;
+    RepCRec::ReplicaSelection selection = RepCRec::ReplicaSelection::LOWEST_SITE;
+    bool printReadStats = false;
+    RepCRec::ExecutionMode execution = RepCRec::ExecutionMode::DETERMINISTIC;
+    bool binaryInput = false;
+    bool emitBinary = false;
+    std::string scriptPath;
+    bool bufferedOutput = false;
+    RepCRec::OutputFormat outputFormat = RepCRec::OutputFormat::TEXT;
+    bool backgroundOutput = true;
+    bool validArgs = true;
+    
+    // Parses the integer after a "--name=" prefix; false if arg is not that option
+    auto parseIntOption = [](const std::string& arg, const std::string& prefix, int& out) {
+        if (arg.compare(0, prefix.size(), prefix) != 0) {
+            return false;
+        }
+        try {
+            out = std::stoi(arg.substr(prefix.size()));
+        } catch (const std::exception&) {
+            out = -1;
+        }
+        return true;
+    };
+    
+    for (int i = 1; i < argc && validArgs; i++) {
+        std::string arg = argv[i];
+        if (arg == "--validation=strict") {
+            mode = RepCRec::ValidationMode::STRICT_GRAPH;
+        } else if (arg == "--validation=flags") {
+            mode = RepCRec::ValidationMode::PIVOT_FLAGS;
+        } else if (arg == "--recovery=gated") {
+            recovery = RepCRec::RecoveryMode::READ_GATE;
+        } else if (arg == "--recovery=catchup") {
+            recovery = RepCRec::RecoveryMode::CATCH_UP;
+        } else if (arg == "--replica-policy=lowest") {
+            selection = RepCRec::ReplicaSelection::LOWEST_SITE;
+        } else if (arg == "--replica-policy=round-robin") {
+            selection = RepCRec::ReplicaSelection::ROUND_ROBIN;
+        } else if (arg == "--replica-policy=least-loaded") {
+            selection = RepCRec::ReplicaSelection::LEAST_OUTSTANDING;
+        } else if (arg == "--replica-policy=affinity") {
+            selection = RepCRec::ReplicaSelection::AFFINITY;
+        } else if (arg == "--read-stats") {
+            printReadStats = true;
+        } else if (arg == "--site-threads") {
+            execution = RepCRec::ExecutionMode::SITE_THREADS;
+        } else if (arg == "--input=text") {
+            binaryInput = false;
+        } else if (arg == "--input=binary") {
+            binaryInput = true;
+        } else if (arg == "--emit-binary") {
+            emitBinary = true;
+        } else if (arg.compare(0, 9, "--script=") == 0 && arg.size() > 9) {
+            scriptPath = arg.substr(9);
+        } else if (arg == "--buffered-output") {
+            bufferedOutput = true;
+        } else if (arg == "--output=text") {
+            outputFormat = RepCRec::OutputFormat::TEXT;
+        } else if (arg == "--output=jsonl") {
+            outputFormat = RepCRec::OutputFormat::JSON_LINES;
+        } else if (arg == "--output=none") {
+            outputFormat = RepCRec::OutputFormat::NONE;
+        } else if (arg == "--inline-output") {
+            backgroundOutput = false;
+        } else if (arg == "--durability=off") {
+            wal.durability = RepCRec::DurabilityLevel::OFF;
+        } else if (arg == "--durability=async") {
+            wal.durability = RepCRec::DurabilityLevel::ASYNC;
+        } else if (arg == "--durability=group") {
+            wal.durability = RepCRec::DurabilityLevel::GROUP;
+        } else if (arg == "--durability=sync") {
+            wal.durability = RepCRec::DurabilityLevel::SYNC;
+        } else if (arg.compare(0, 10, "--wal-dir=") == 0 && arg.size() > 10) {
+            wal.directory = arg.substr(10);
+        } else if (parseIntOption(arg, "--group-commit=", wal.groupCommitSize)) {
+            validArgs = wal.groupCommitSize >= 1;
+        } else if (parseIntOption(arg, "--checkpoint-every=", wal.checkpointInterval)) {
+            validArgs = wal.checkpointInterval >= 0;
+        } else if (parseIntOption(arg, "--variables=", catalog.numVariables) ||
+                   parseIntOption(arg, "--sites=", catalog.numSites) ||
+                   parseIntOption(arg, "--replication=", catalog.replicationFactor)) {
+            continue;
+        } else {
+            validArgs = false;
+        }
+    }
+    
+    if (!validArgs || !RepCRec::configureCatalog(catalog)) {
+        std::cerr << "Usage: " << argv[0] << " [--validation=strict|flags] [--variables=N]"
+                  << " [--sites=1.." << RepCRec::MAX_SITES << "] [--replication=N]"
+                  << " [--durability=off|async|group|sync] [--wal-dir=PATH]"
+                  << " [--group-commit=N] [--checkpoint-every=N]"
+                  << " [--recovery=gated|catchup]"
+                  << " [--replica-policy=lowest|round-robin|least-loaded|affinity]"
+                  << " [--read-stats] [--site-threads]"
+                  << " [--input=text|binary] [--emit-binary] [--buffered-output]"
+                  << " [--script=PATH] [--output=text|jsonl|none] [--inline-output]"
+                  << std::endl;
+        return 1;
+    }
+    
+    // Convert a text script from stdin to a binary script on stdout; 
+    // malformed lines are listed on stderr and kept as error frames
+    if (emitBinary) {
+        RepCRec::BinaryScriptWriter writer;
+        RepCRec::Parser::convertToBinary(std::cin, writer, std::cerr);
+        const auto& bytes = writer.getBytes();
+        std::fwrite(bytes.data(), 1, bytes.size(), stdout);
+        return 0;
+    }
     
-    auto tm = std::make_shared<RepCRec::TransactionManager>();
+    // Bulk replay: parse the script in place from a mapping of the file
+    std::unique_ptr<RepCRec::MappedScript> script;
+    if (!scriptPath.empty()) {
+        try {
+            script = std::make_unique<RepCRec::MappedScript>(scriptPath);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
+    // Output in large chunks, ignoring the per-line std::endl flushes
+    std::unique_ptr<RepCRec::BulkOutputBuffer> bulkOutput;
+    if (bufferedOutput) {
+        bulkOutput = std::make_unique<RepCRec::BulkOutputBuffer>(std::cout, STDOUT_FILENO);
+    }
+    
+    // The banner and footer would break a JSON-lines stream
+    bool textOutput = outputFormat == RepCRec::OutputFormat::TEXT;
+    if (textOutput) {
+        std::cout << "RepCRec - Distributed Database with SSI and Available Copies" << std::endl;
+        std::cout << "=============================================================" << std::endl << std::endl;
+    }
+    
+    std::shared_ptr<RepCRec::TransactionManager> tm;
+    try {
+        tm = std::make_shared<RepCRec::TransactionManager>(mode, wal, recovery, selection, execution);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    
+    // Events are formatted and written on a background thread by default
+    tm->setEventSink(RepCRec::makeEventSink(outputFormat, std::cout, backgroundOutput));
     
     RepCRec::Parser parser(tm);
     
-    parser.run();
+    bool inputOk = true;
+    if (script && binaryInput) {
+        inputOk = parser.runBinary(script->data(), script->size());
+    } else if (script) {
+        parser.runText(script->data(), script->size());
+    } else if (binaryInput) {
+        std::vector<char> contents = readAll(stdin);
+        inputOk = parser.runBinary(contents.data(), contents.size());
+    } else {
+        parser.run();
+    }
+    
+    tm->flushEvents();
+    
+    if (printReadStats) {
+        const auto& reads = tm->getReadsServedBySite();
+        std::cout << "\nReads served per site:";
+        for (int siteId = 1; siteId <= RepCRec::getNumSites(); siteId++) {
+            std::cout << " " << siteId << "=" << reads[siteId];
+        }
+        std::cout << std::endl;
+    }
     
-    std::cout << "\n=============================================================" << std::endl;
-    std::cout << "RepCRec execution complete" << std::endl;
+    if (textOutput) {
+        std::cout << "\n=============================================================" << std::endl;
+        std::cout << "RepCRec execution complete" << std::endl;
+    }
     
-    return 0;
+    return inputOk ? 0 : 1;
 }
\ No newline at end of file
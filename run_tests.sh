@@ -20,22 +20,76 @@ if [ ! -f "./repcrec" ]; then
     fi
 fi
 
+# Lines a test reports: commits, aborts, reads, waits and errors
+OUTCOME_PATTERN="(commits|aborts|x[0-9]+:.*[0-9]|waits|Retry|Error|catches up|Reads served)"
+
 # Function to run a single test
+# Optional 5th argument: command-line flags for repcrec
 run_test() {
     local test_num=$1
     local test_name=$2
     local test_input=$3
     local expected=$4
+    local flags=$5
     
-    echo -e "${YELLOW}Test $test_num: $test_name ${NC}"
-    result=$(echo "$test_input" | ./repcrec 2>&1)
+    echo -e "${YELLOW}Test $test_num: $test_name ${flags:+($flags)}${NC}"
+    result=$(echo "$test_input" | ./repcrec $flags 2>&1)
     
     # Extract commit/abort lines
-    outcome=$(echo "$result" | grep -E "(commits|aborts|x[0-9]+:.*[0-9]|waits|Retry)")
+    outcome=$(echo "$result" | grep -E "$OUTCOME_PATTERN")
     echo "$outcome"
     echo ""
 }
 
+# Function to run a test across restarts
+# Each script after the 5th argument runs in a new repcrec process with the
+# given flags and the same fresh --wal-dir. The 5th argument, if not empty,
+# is a shell command run after the first process exits (with $wal_dir set).
+run_restart_test() {
+    local test_num=$1
+    local test_name=$2
+    local expected=$3
+    local flags=$4
+    local between=$5
+    shift 5
+    
+    echo -e "${YELLOW}Test $test_num: $test_name ($flags, restarted)${NC}"
+    local wal_dir=$(mktemp -d)
+    local run=0
+    for script in "$@"; do
+        if [ $run -eq 1 ] && [ -n "$between" ]; then
+            eval "$between"
+        fi
+        run=$((run + 1))
+        echo "-- run $run"
+        echo "$script" | ./repcrec $flags --wal-dir="$wal_dir" 2>&1 | grep -E "$OUTCOME_PATTERN"
+    done
+    rm -rf "$wal_dir"
+    echo ""
+}
+
+# Function to run a test through the binary command protocol
+# Converts the script with --emit-binary, replays it with --input=binary and
+# checks the replay prints exactly what the text script prints.
+run_binary_test() {
+    local test_num=$1
+    local test_name=$2
+    local test_input=$3
+    local expected=$4
+    
+    echo -e "${YELLOW}Test $test_num: $test_name (--emit-binary | --input=binary)${NC}"
+    text_result=$(echo "$test_input" | ./repcrec 2>&1)
+    result=$(echo "$test_input" | ./repcrec --emit-binary 2>/dev/null | ./repcrec --input=binary 2>&1)
+    
+    echo "$result" | grep -E "$OUTCOME_PATTERN"
+    if [ "$result" == "$text_result" ]; then
+        echo "Binary replay matches the text output"
+    else
+        echo -e "${RED}Binary replay differs from the text output${NC}"
+    fi
+    echo ""
+}
+
 # Test 1
 test1() {
     run_test "1" "First-Committer-Wins" 'begin(T1)
@@ -474,6 +528,126 @@ recover(2)
 end(T3)' "T3 waits, reads x8=88, commits"
 }
 
+# Test 26
+test26() {
+    run_test "26" "Out-of-Range Variables Rejected" 'begin(T1)
+begin(T2)
+W(T1,x400,1)
+R(T1,x0)
+W(T1,x2,22)
+R(T2,x21)
+end(T1)
+end(T2)
+dump()' "Errors for x400, x0, x21; T1 and T2 commit"
+}
+
+# Test 27
+test27() {
+    run_test "27" "Doomed Reader Under Pivot Flags" 'begin(T1)
+begin(T2)
+begin(T3)
+R(T1,x2)
+R(T2,x4)
+R(T3,x6)
+W(T3,x4,44)
+end(T3)
+W(T2,x2,22)
+end(T2)
+W(T1,x6,66)
+end(T1)
+dump()' "T3, T2 commit; T1 aborts (RW-cycle), as in strict mode" "--validation=flags"
+}
+
+# Test 28
+test28() {
+    run_restart_test "28" "WAL Replay After Restart" \
+        "run 2: x1=11 at site 2, x2=22 everywhere; T2's uncommitted x2=33 is lost" \
+        "--durability=sync" "" 'begin(T1)
+W(T1,x1,11)
+W(T1,x2,22)
+end(T1)
+begin(T2)
+W(T2,x2,33)' 'dump()'
+}
+
+# Test 29
+test29() {
+    run_restart_test "29" "Torn Log Tail Truncated on Restart" \
+        "run 2 reads x1=11 and T3 commits; run 3 dump shows x1=44 at site 2" \
+        "--durability=sync" 'printf "\x20\x00\x00\x00\x01\x02" >> "$wal_dir/site2.wal"' 'begin(T1)
+W(T1,x1,11)
+end(T1)' 'begin(T3)
+R(T3,x1)
+W(T3,x1,44)
+end(T3)' 'dump()'
+}
+
+# Test 30
+test30() {
+    run_restart_test "30" "Checkpoint Truncates the Log" \
+        "site2.wal empty after the checkpoint, site4.wal holds T3; run 2: x1=12 at site 2, x3=33 at site 4" \
+        "--durability=sync --checkpoint-every=2" \
+        'echo "site2.wal: $(wc -c < "$wal_dir/site2.wal") bytes, site4.wal: $(wc -c < "$wal_dir/site4.wal") bytes"' 'begin(T1)
+W(T1,x1,11)
+end(T1)
+begin(T2)
+W(T2,x1,12)
+W(T2,x2,22)
+end(T2)
+begin(T3)
+W(T3,x3,33)
+end(T3)' 'dump()'
+}
+
+# Test 31
+test31() {
+    run_test "31" "Recovered Site Catches Up" 'fail(2)
+begin(T1)
+W(T1,x2,22)
+end(T1)
+recover(2)
+fail(1)
+fail(3)
+fail(4)
+fail(5)
+fail(6)
+fail(7)
+fail(8)
+fail(9)
+fail(10)
+begin(T2)
+R(T2,x2)
+end(T2)' "Site 2 catches up on recover; T2 reads x2=22 from it and commits (gated mode aborts T2)" "--recovery=catchup"
+}
+
+# Test 32
+test32() {
+    run_test "32" "Least-Loaded Replica Selection" 'fail(1)
+begin(T1)
+begin(T2)
+R(T1,x2)
+R(T1,x4)
+R(T2,x6)
+end(T1)
+R(T2,x8)
+R(T2,x10)
+end(T2)' "Same reads and commits as the default policy; the five reads go to five different up sites, none to site 1" "--replica-policy=least-loaded --read-stats"
+}
+
+# Test 33
+test33() {
+    run_binary_test "33" "Binary Script Round Trip" 'begin(T1)
+begin(T2)
+W(T1,x1,11)
+R(T2,x1)
+R(T2 x2
+W(T2,x4,44)
+bogus(T3)
+end(T1)
+end(T2)
+dump()' "Errors for the two malformed lines in place; T1 and T2 commit; output identical to text mode"
+}
+
 # Main execution
 echo -e "${GREEN}RepCRec Test Suite - Tests mentioned in official website${NC}"
 echo ""
@@ -507,6 +681,14 @@ if [ $# -eq 0 ]; then
     test23
     test24
     test25
+    test26
+    test27
+    test28
+    test29
+    test30
+    test31
+    test32
+    test33
     
     echo -e "${GREEN}All tests completed!${NC}"
 else
@@ -539,6 +721,14 @@ else
         23) test23 ;;
         24) test24 ;;
         25) test25 ;;
-        *) echo "Unknown test: $1. Valid tests: 1-25, 3.5, 3.7" ;;
+        26) test26 ;;
+        27) test27 ;;
+        28) test28 ;;
+        29) test29 ;;
+        30) test30 ;;
+        31) test31 ;;
+        32) test32 ;;
+        33) test33 ;;
+        *) echo "Unknown test: $1. Valid tests: 1-33, 3.5, 3.7" ;;
     esac
 fi
\ No newline at end of file